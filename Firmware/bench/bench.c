@@ -0,0 +1,313 @@
+/*
+ * bench.c
+ *
+ * Host benchmark of the JSON paths on the generated corpus. The same source is built once per
+ * variant of the library (see the Makefile), each binary prints one row:
+ *   parse/lookup/print/delete  ns per message for each step, lookup takes command, nodeID and data
+ *   parse allocs               calls of the allocation hook per message while parsing
+ *   allocs/msg                 calls of the allocation hook per message, all steps
+ *   peak B                     most JSON memory held at once while handling one message
+ * Only parsed messages are looked up, printed and deleted, malformed ones count for parse only.
+ *
+ *   bench_<variant> [rounds]   run over the corpus that many times (default 200)
+ *   bench_<variant> -d         print the corpus, one message per line
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "cJSON.h"
+#include "corpus.h"
+#ifdef BENCH_PUSH
+#include "cJSON_Push.h"
+#endif
+
+#ifndef BENCH_NAME
+#define BENCH_NAME "tree"
+#endif
+#define CORPUS_SIZE 256
+#define CORPUS_SEED 1
+#define DEFAULT_ROUNDS 200
+
+enum { STEP_PARSE, STEP_LOOKUP, STEP_PRINT, STEP_DELETE, STEPS };
+
+static uint64_t stepNs[STEPS];
+static uint64_t stepOps[STEPS];
+static uint64_t clockOverhead;
+static volatile uintptr_t sink; // keeps the lookups from being optimized away
+
+static uint64_t now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+// Smallest difference of two back to back readings, taken off every measured step
+static void calibrateClock(void)
+{
+	int i;
+
+	clockOverhead = UINT64_MAX;
+	for (i = 0; i < 10000; i++) {
+		uint64_t start = now(), delta = now() - start;
+		if (delta < clockOverhead)
+			clockOverhead = delta;
+	}
+}
+
+static void addStep(int step, uint64_t start, uint64_t end)
+{
+	uint64_t delta = end - start;
+
+	stepNs[step] += (delta > clockOverhead) ? delta - clockOverhead : 0;
+	stepOps[step]++;
+}
+
+/* Memory accounting. The pool variant keeps its own hooks, its allocations are the ones that went
+ * to malloc and its peak is the pool slot memory in use (without what went to malloc). Everything
+ * else goes through counting hooks, the arena variants add the arena they used to the peak. */
+static uint64_t parseAllocations;
+static size_t heapLive, heapPeak, messagePeak;
+
+#ifndef CJSON_POOL
+static uint64_t allocations;
+
+typedef union {
+	size_t size;
+	max_align_t align;
+} HeapHeader;
+
+static void *countingMalloc(size_t size)
+{
+	HeapHeader *header = malloc(sizeof(HeapHeader) + size);
+
+	if (header == NULL)
+		return NULL;
+	header->size = size;
+	allocations++;
+	heapLive += size;
+	if (heapLive > heapPeak)
+		heapPeak = heapLive;
+	return header + 1;
+}
+
+static void countingFree(void *pointer)
+{
+	HeapHeader *header = (HeapHeader *)pointer - 1;
+
+	if (pointer == NULL)
+		return;
+	heapLive -= header->size;
+	free(header);
+}
+#endif
+
+// Allocations so far, those of the counting hooks or those the pool passed on to malloc
+static uint64_t allocationCount(void)
+{
+#if defined(CJSON_POOL)
+	cJSON_PoolStats stats;
+
+	cJSON_GetPoolStats(&stats);
+	return stats.heap_allocations;
+#else
+	return allocations;
+#endif
+}
+
+#if defined(CJSON_ARENA)
+static double arenaStorage[64 * 1024 / sizeof(double)];
+static cJSON_Arena arena;
+#endif
+#if defined(CJSON_IN_SITU)
+static char inSituCopy[4096];
+#endif
+
+#ifdef BENCH_PUSH
+// Destination of the decoder, JsonMessage of the firmware
+typedef struct {
+	char command[64];
+	int nodeID;
+	char data[32];
+} Message;
+
+static const cJSON_PushField messageFields[] = {
+	cJSON_PushFieldOf("command", cJSON_String, Message, command),
+	cJSON_PushFieldOf("nodeID", cJSON_Number, Message, nodeID),
+	cJSON_PushFieldOf("data", cJSON_String, Message, data)
+};
+
+static cJSON_PushParser pushParser;
+static cJSON_PushRecord pushRecord;
+static Message pushMessage;
+
+static void pushCallback(const cJSON_PushParser *parser, cJSON_PushEvent event, void *user_data)
+{
+	cJSON_PushRecord *record = (cJSON_PushRecord *)user_data;
+
+	if (event == cJSON_PushMember) {
+		cJSON_PushRecordMember(record, parser);
+		return;
+	}
+	if (event == cJSON_PushObjectEnd && cJSON_PushRecordComplete(record, 1UL << 0))
+		sink += (uintptr_t)pushMessage.nodeID;
+	memset(&pushMessage, 0, sizeof(pushMessage));
+	cJSON_PushRecordReset(record);
+}
+
+// Decoding feeds the bytes and stores the fields, there is no tree to look up, print or delete
+static void runMessage(const CorpusMessage *message)
+{
+	uint64_t allocationsBefore = allocationCount();
+	uint64_t start = now();
+
+	cJSON_PushBytes(&pushParser, (const unsigned char *)message->text, message->length);
+	addStep(STEP_PARSE, start, now());
+	parseAllocations += allocationCount() - allocationsBefore;
+
+	// a malformed frame must not leave the tokenizer inside an object for the next message
+	cJSON_PushReset(&pushParser);
+	messagePeak = sizeof(pushParser) + sizeof(pushRecord) + sizeof(pushMessage);
+}
+#else
+static cJSON *parseMessage(const CorpusMessage *message)
+{
+#if defined(CJSON_IN_SITU)
+	return cJSON_ParseInSitu(inSituCopy, message->length, NULL, 0, &arena);
+#elif defined(CJSON_ARENA)
+	return cJSON_ParseWithArena(message->text, message->length, NULL, 0, &arena);
+#else
+	return cJSON_ParseWithLength(message->text, message->length);
+#endif
+}
+
+static size_t memoryInUse(void)
+{
+#if defined(CJSON_POOL)
+	cJSON_PoolStats stats;
+
+	cJSON_GetPoolStats(&stats);
+	return stats.nodes_used * sizeof(cJSON) + stats.strings_used * CJSON_POOL_STRING_SIZE;
+#elif defined(CJSON_ARENA)
+	return heapPeak + arena.offset;
+#else
+	return heapPeak;
+#endif
+}
+
+static void runMessage(const CorpusMessage *message)
+{
+	uint64_t start, end, allocationsBefore;
+	cJSON *root;
+	char *printed;
+
+#if defined(CJSON_IN_SITU)
+	// the firmware would parse the receive buffer itself, the copy stands in for it and isn't timed
+	memcpy(inSituCopy, message->text, message->length + 1);
+#endif
+	heapPeak = heapLive;
+
+	allocationsBefore = allocationCount();
+	start = now();
+	root = parseMessage(message);
+	end = now();
+	addStep(STEP_PARSE, start, end);
+	parseAllocations += allocationCount() - allocationsBefore;
+	if (root == NULL)
+		return;
+
+	start = now();
+	sink += (uintptr_t)cJSON_GetObjectItemCaseSensitive(root, "command");
+	sink += (uintptr_t)cJSON_GetObjectItemCaseSensitive(root, "nodeID");
+	sink += (uintptr_t)cJSON_GetObjectItemCaseSensitive(root, "data");
+	end = now();
+	addStep(STEP_LOOKUP, start, end);
+
+	start = now();
+	printed = cJSON_PrintUnformatted(root);
+	end = now();
+	addStep(STEP_PRINT, start, end);
+	if (memoryInUse() > messagePeak)
+		messagePeak = memoryInUse();
+	cJSON_free(printed);
+
+	start = now();
+#if defined(CJSON_ARENA)
+	cJSON_ResetArena(&arena);
+#else
+	cJSON_Delete(root);
+#endif
+	end = now();
+	addStep(STEP_DELETE, start, end);
+}
+#endif
+
+static void printStep(int step)
+{
+	if (stepOps[step] == 0)
+		printf(" %10s", "-");
+	else
+		printf(" %10.1f", (double)stepNs[step] / (double)stepOps[step]);
+}
+
+int main(int argc, char **argv)
+{
+	static CorpusMessage corpus[CORPUS_SIZE];
+	size_t count = corpusGenerate(corpus, CORPUS_SIZE, CORPUS_SEED);
+	long rounds = DEFAULT_ROUNDS;
+	size_t i;
+	long round;
+	int step;
+	uint64_t allocationsBefore, allocationsTotal;
+
+	if (argc > 1 && strcmp(argv[1], "-d") == 0) {
+		for (i = 0; i < count; i++)
+			printf("%s\n", corpus[i].text);
+		corpusFree(corpus, count);
+		return 0;
+	}
+	if (argc > 1)
+		rounds = atol(argv[1]);
+
+#if !defined(CJSON_POOL)
+	{
+		cJSON_Hooks hooks = { countingMalloc, countingFree };
+		cJSON_InitHooks(&hooks);
+	}
+#endif
+#if defined(CJSON_ARENA)
+	cJSON_InitArena(&arena, arenaStorage, sizeof(arenaStorage));
+#endif
+#ifdef BENCH_PUSH
+	cJSON_PushInit(&pushParser, pushCallback, &pushRecord);
+	cJSON_PushRecordInit(&pushRecord, messageFields, sizeof(messageFields) / sizeof(messageFields[0]), &pushMessage);
+#endif
+
+	// one round to warm up the caches, then the measured ones
+	for (i = 0; i < count; i++)
+		runMessage(&corpus[i]);
+	memset(stepNs, 0, sizeof(stepNs));
+	memset(stepOps, 0, sizeof(stepOps));
+	parseAllocations = 0;
+	calibrateClock();
+
+	allocationsBefore = allocationCount();
+	for (round = 0; round < rounds; round++)
+		for (i = 0; i < count; i++)
+			runMessage(&corpus[i]);
+	allocationsTotal = allocationCount() - allocationsBefore;
+
+	printf("%-10s", BENCH_NAME);
+	for (step = 0; step < STEPS; step++)
+		printStep(step);
+	printf(" %12.2f %10.2f %8zu\n", (double)parseAllocations / (double)(count * (size_t)rounds),
+			(double)allocationsTotal / (double)(count * (size_t)rounds), messagePeak);
+
+	corpusFree(corpus, count);
+	return 0;
+}
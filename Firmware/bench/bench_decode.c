@@ -0,0 +1,172 @@
+/*
+ * bench_decode.c
+ *
+ * Decoding a command into JsonMessage: the cJSON_Push field schema the firmware uses, against the tree
+ * path it replaced (cJSON_Parse, three cJSON_GetObjectItemCaseSensitive calls, copying the fields and
+ * cJSON_Delete). Both run over the same corpus messages, the result is printed per kind of message:
+ * ns per message of each path, the ratio, and the allocations per message of the tree path.
+ * Every timing is the fastest of REPEATS runs, which keeps other load on the host out of the ratio.
+ *
+ *   bench_decode [rounds]
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cJSON.h"
+#include "cJSON_Push.h"
+#include "corpus.h"
+
+#define CORPUS_SIZE 256
+#define CORPUS_SEED 1
+#define DEFAULT_ROUNDS 200
+#define REPEATS 5
+
+// JsonMessage of the firmware
+typedef struct {
+	char command[64];
+	int nodeID;
+	char data[32];
+} Message;
+
+static const cJSON_PushField messageFields[] = {
+	cJSON_PushFieldOf("command", cJSON_String, Message, command),
+	cJSON_PushFieldOf("nodeID", cJSON_Number, Message, nodeID),
+	cJSON_PushFieldOf("data", cJSON_String, Message, data)
+};
+
+static cJSON_PushParser pushParser;
+static cJSON_PushRecord pushRecord;
+static Message message;
+static int decoded; // set when the message was complete
+static uint64_t allocations;
+
+static uint64_t now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+static void *countingMalloc(size_t size)
+{
+	allocations++;
+	return malloc(size);
+}
+
+static void pushCallback(const cJSON_PushParser *parser, cJSON_PushEvent event, void *user_data)
+{
+	cJSON_PushRecord *record = (cJSON_PushRecord *)user_data;
+
+	if (event == cJSON_PushMember) {
+		cJSON_PushRecordMember(record, parser);
+		return;
+	}
+	decoded = (event == cJSON_PushObjectEnd) && cJSON_PushRecordComplete(record, 1UL << 0);
+	cJSON_PushRecordReset(record);
+}
+
+static int decodePush(const CorpusMessage *text)
+{
+	decoded = 0;
+	memset(&message, 0, sizeof(message));
+	cJSON_PushBytes(&pushParser, (const unsigned char *)text->text, text->length);
+	cJSON_PushReset(&pushParser);
+	return decoded;
+}
+
+// What JsonProcessingTask did before the schema decoder
+static int decodeTree(const CorpusMessage *text)
+{
+	cJSON *root = cJSON_ParseWithLength(text->text, text->length);
+	const cJSON *command, *nodeID, *data;
+
+	memset(&message, 0, sizeof(message));
+	if (root == NULL)
+		return 0;
+
+	command = cJSON_GetObjectItemCaseSensitive(root, "command");
+	nodeID = cJSON_GetObjectItemCaseSensitive(root, "nodeID");
+	data = cJSON_GetObjectItemCaseSensitive(root, "data");
+	if (cJSON_IsString(command))
+		strncpy(message.command, command->valuestring, sizeof(message.command) - 1);
+	if (cJSON_IsNumber(nodeID))
+		message.nodeID = nodeID->valueint;
+	if (cJSON_IsString(data))
+		strncpy(message.data, data->valuestring, sizeof(message.data) - 1);
+
+	cJSON_Delete(root);
+	return cJSON_IsString(command);
+}
+
+static uint64_t timeKind(int (*decode)(const CorpusMessage *), const CorpusMessage *corpus, size_t count,
+		CorpusKind kind, long rounds, size_t *messages)
+{
+	uint64_t start;
+	size_t i;
+	long round;
+
+	uint64_t fastest = UINT64_MAX;
+	int repeat;
+
+	*messages = 0;
+	for (i = 0; i < count; i++)
+		if (corpus[i].kind == kind)
+			(*messages)++;
+
+	for (repeat = 0; repeat < REPEATS; repeat++) {
+		start = now();
+		for (round = 0; round < rounds; round++)
+			for (i = 0; i < count; i++)
+				if (corpus[i].kind == kind)
+					decode(&corpus[i]);
+		if (now() - start < fastest)
+			fastest = now() - start;
+	}
+	return fastest;
+}
+
+int main(int argc, char **argv)
+{
+	static CorpusMessage corpus[CORPUS_SIZE];
+	size_t count = corpusGenerate(corpus, CORPUS_SIZE, CORPUS_SEED);
+	long rounds = (argc > 1) ? atol(argv[1]) : DEFAULT_ROUNDS;
+	cJSON_Hooks hooks = { countingMalloc, free };
+	int kind;
+	size_t i;
+
+	cJSON_InitHooks(&hooks);
+	cJSON_PushInit(&pushParser, pushCallback, &pushRecord);
+	cJSON_PushRecordInit(&pushRecord, messageFields, sizeof(messageFields) / sizeof(messageFields[0]), &message);
+
+	// both paths must agree on what they decode, apart from values that don't fit JsonMessage
+	for (i = 0; i < count; i++) {
+		if (corpus[i].kind == CORPUS_COMMAND && decodePush(&corpus[i]) != decodeTree(&corpus[i])) {
+			fprintf(stderr, "paths disagree on %s\n", corpus[i].text);
+			return 1;
+		}
+	}
+
+	printf("%-10s %8s %10s %10s %7s %11s\n", "kind", "messages", "push ns", "tree ns", "ratio", "tree allocs");
+	for (kind = 0; kind < CORPUS_KINDS; kind++) {
+		size_t messages = 0;
+		uint64_t pushNs, treeNs, treeAllocations;
+
+		pushNs = timeKind(decodePush, corpus, count, (CorpusKind)kind, rounds, &messages);
+		allocations = 0;
+		treeNs = timeKind(decodeTree, corpus, count, (CorpusKind)kind, rounds, &messages);
+		treeAllocations = allocations;
+		if (messages == 0)
+			continue;
+
+		printf("%-10s %8zu %10.1f %10.1f %7.2f %11.2f\n", corpusKindNames[kind], messages,
+				(double)pushNs / (double)(messages * rounds), (double)treeNs / (double)(messages * rounds),
+				(double)treeNs / (double)pushNs, (double)treeAllocations / (double)(messages * rounds * REPEATS));
+	}
+
+	corpusFree(corpus, count);
+	return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * bench_framing.c
+ *
+ * Bytes on the wire of the two framings of the command link: the same commands and reports as the JSON
+ * text the gateway and the firmware send, and as the COBS frames of the binary framing (cobs_frame.c).
+ * For every message it prints both sizes, their ratio and how many of them fit into one second of a
+ * 9600 baud 8N1 link (10 bits per byte), then the same over all commands and over all reports.
+ *
+ *   bench_framing
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "cobs_frame.h"
+
+#define BAUD_RATE 9600
+#define BITS_PER_BYTE 10 // Start bit, 8 data bits and a stop bit
+
+// Frame types of main.c
+#define FRAME_TEXT 0x10
+#define FRAME_READING 0x20
+#define FRAME_COUNTERS 0x30
+#define FRAME_NS 1
+#define FRAME_NA 2
+#define FRAME_SYS 3
+
+typedef struct {
+	const char *name;
+	const char *json;       // Text as it is sent in JSON mode
+	uint8_t type;           // Frame type in binary mode
+	uint8_t nodeID;         // First byte of the payload
+	const uint8_t *body;    // Rest of the payload
+	uint16_t bodyLength;
+} Message;
+
+// Command frame: the type is the command code + 1, the payload the node ID and the data text
+#define COMMAND(name, code, nodeID, data) \
+	{ name, "{\"command\":\"" name "\",\"nodeID\":" #nodeID ",\"data\":\"" data "\"}", \
+	  (code) + 1, nodeID, (const uint8_t *)(data), sizeof(data) - 1 }
+#define BYTES(...) (const uint8_t[]){ __VA_ARGS__ }, sizeof((const uint8_t[]){ __VA_ARGS__ })
+
+static const Message commands[] = {
+	COMMAND("ENA", 0, 128, ""),
+	COMMAND("DIS", 1, 128, ""),
+	COMMAND("ACT", 2, 80, "1"),
+	COMMAND("STA", 3, 80, ""),
+	COMMAND("DUR", 4, 128, "5"),
+	COMMAND("BAU", 5, 0, "115200"),
+	COMMAND("LNK", 6, 0, "")
+};
+
+static const Message reports[] = {
+	// sendNodeReading: node ID, 32 bit little endian value, unit
+	{ "NS reading", "{\"nodeType\":\"NS\",\"nodeID\":128,\"data\":\"25\xC2\xB0" "C\"}",
+	  FRAME_READING | FRAME_NS, 128, BYTES(25, 0, 0, 0, 0xC2, 0xB0, 'C') },
+	{ "NS light", "{\"nodeType\":\"NS\",\"nodeID\":129,\"data\":\"734\"}",
+	  FRAME_READING | FRAME_NS, 129, BYTES(0xDE, 0x02, 0, 0) },
+	{ "NA status", "{\"nodeType\":\"NA\",\"nodeID\":80,\"data\":\"1\"}",
+	  FRAME_READING | FRAME_NA, 80, BYTES(1, 0, 0, 0) },
+	// sendNodeMessage: node ID and the text
+	{ "NS DONE", "{\"nodeType\":\"NS\",\"nodeID\":128,\"data\":\"DONE\"}",
+	  FRAME_TEXT | FRAME_NS, 128, BYTES('D', 'O', 'N', 'E') },
+	// sendLinkStatus: node ID and seven 32 bit counters, LAT_CYC 412 and LATMAX_CYC 1530
+	{ "SYS LNK", "{\"nodeType\":\"SYS\",\"nodeID\":0,\"data\":{\"ORE\":0,\"FE\":0,\"NE\":0,\"PE\":0,\"OVW\":0,"
+	  "\"LAT_CYC\":412,\"LATMAX_CYC\":1530}}",
+	  FRAME_COUNTERS | FRAME_SYS, 0, BYTES(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	  0x9C, 0x01, 0, 0, 0xFA, 0x05, 0, 0) }
+};
+
+static double messagesPerSecond(double bytes)
+{
+	return (double)BAUD_RATE / BITS_PER_BYTE / bytes;
+}
+
+static void printRow(const char *name, double jsonBytes, double cobsBytes)
+{
+	printf("%-12s %8.1f %8.1f %8.2f %10.1f %10.1f\n", name, jsonBytes, cobsBytes, jsonBytes / cobsBytes,
+		messagesPerSecond(jsonBytes), messagesPerSecond(cobsBytes));
+}
+
+// Print every message of the list and then their average, returns 0 if a frame does not decode again
+static int measure(const char *title, const Message *messages, size_t count)
+{
+	uint8_t payload[COBS_FRAME_MAX_PAYLOAD];
+	uint8_t frame[COBS_FRAME_MAX_ENCODED];
+	CobsDecoder decoder;
+	size_t jsonTotal = 0, cobsTotal = 0;
+	size_t i;
+
+	cobsDecoderInit(&decoder);
+	for (i = 0; i < count; i++) {
+		uint16_t payloadLength = (uint16_t)(1 + messages[i].bodyLength);
+		size_t jsonBytes = strlen(messages[i].json);
+		uint16_t cobsBytes;
+		CobsFrameResult result = COBS_FRAME_NONE;
+		uint16_t j;
+
+		payload[0] = messages[i].nodeID;
+		memcpy(&payload[1], messages[i].body, messages[i].bodyLength);
+		cobsBytes = cobsEncodeFrame(messages[i].type, payload, payloadLength, frame);
+
+		// The frame must be what the other end decodes
+		for (j = 0; j < cobsBytes; j++) {
+			result = cobsDecoderPush(&decoder, frame[j]);
+		}
+		if (result != COBS_FRAME_OK || cobsFrameType(&decoder) != messages[i].type
+				|| cobsFramePayloadLength(&decoder) != payloadLength
+				|| memcmp(cobsFramePayload(&decoder), payload, payloadLength) != 0) {
+			fprintf(stderr, "%s: frame does not decode\n", messages[i].name);
+			return 0;
+		}
+
+		printRow(messages[i].name, (double)jsonBytes, (double)cobsBytes);
+		jsonTotal += jsonBytes;
+		cobsTotal += cobsBytes;
+	}
+	printRow(title, (double)jsonTotal / (double)count, (double)cobsTotal / (double)count);
+	printf("\n");
+	return 1;
+}
+
+int main(void)
+{
+	printf("%-12s %8s %8s %8s %10s %10s\n", "message", "JSON B", "COBS B", "ratio", "JSON msg/s", "COBS msg/s");
+	if (!measure("commands", commands, sizeof(commands) / sizeof(commands[0]))
+			|| !measure("reports", reports, sizeof(reports) / sizeof(reports[0]))) {
+		return 1;
+	}
+	return 0;
+}
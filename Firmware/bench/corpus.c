@@ -0,0 +1,190 @@
+/*
+ * corpus.c
+ *
+ * Messages are built from the formats main.c sends and accepts. The mix is weighted towards plain
+ * commands and reports, which make up the traffic of the link, with a share of the harder cases.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "corpus.h"
+
+#define MESSAGE_MAX 2048
+
+const char *const corpusKindNames[CORPUS_KINDS] = { "command", "escapes", "large", "report", "malformed" };
+
+static const char *const commands[] = { "ENA", "DIS", "ACT", "STA", "DUR", "BAU", "LNK", "ABD", "BIN", "JSN" };
+static const int nodeIDs[] = { 128, 129, 80, 0 };
+static const char *const whitespace[] = { "", "", "", " ", "  ", "\t", " \t " };
+
+// Small LCG, the corpus must not depend on the C library's rand()
+static unsigned long corpusState;
+
+static unsigned corpusRandom(unsigned range)
+{
+	corpusState = corpusState * 1103515245UL + 12345UL;
+	return (unsigned)((corpusState >> 16) & 0x7FFF) % range;
+}
+
+#define PICK(array) (array)[corpusRandom(sizeof(array) / sizeof((array)[0]))]
+
+// Data of a command of the given type, as the handlers expect it
+static const char *commandData(const char *command)
+{
+	static const char *const baudRates[] = { "9600", "19200", "57600", "115200" };
+	static const char *const periods[] = { "1", "2", "10", "3600" };
+
+	if (strcmp(command, "ACT") == 0)
+		return corpusRandom(2) ? "1" : "0";
+	if (strcmp(command, "DUR") == 0)
+		return PICK(periods);
+	if (strcmp(command, "BAU") == 0)
+		return PICK(baudRates);
+	if (strcmp(command, "BIN") == 0)
+		return "COBS1";
+	return NULL;
+}
+
+// {"command":..,"nodeID":..,"data":..} with the members in a random order and random whitespace
+static int formatCommand(char *out, size_t size, const char *command, int nodeID, const char *data, const char *extra)
+{
+	char members[4][MESSAGE_MAX / 2];
+	int count = 0, length = 0, i;
+
+	snprintf(members[count++], sizeof(members[0]), "\"command\":%s\"%s\"", PICK(whitespace), command);
+	snprintf(members[count++], sizeof(members[0]), "\"nodeID\"%s:%d", PICK(whitespace), nodeID);
+	if (data != NULL)
+		snprintf(members[count++], sizeof(members[0]), "\"data\":\"%s\"", data);
+	if (extra != NULL)
+		snprintf(members[count++], sizeof(members[0]), "%s", extra);
+
+	// the gateway sends the command first, other senders don't always
+	for (i = count - 1; i > 0; i--) {
+		if (corpusRandom(4) == 0) {
+			char swap[sizeof(members[0])];
+			int j = (int)corpusRandom((unsigned)i + 1);
+			memcpy(swap, members[i], sizeof(swap));
+			memcpy(members[i], members[j], sizeof(swap));
+			memcpy(members[j], swap, sizeof(swap));
+		}
+	}
+
+	length += snprintf(out + length, size - length, "{%s", PICK(whitespace));
+	for (i = 0; i < count; i++)
+		length += snprintf(out + length, size - length, "%s%s%s", i ? "," : "", PICK(whitespace), members[i]);
+	length += snprintf(out + length, size - length, "%s}", PICK(whitespace));
+	return length;
+}
+
+static int generateCommand(char *out, size_t size)
+{
+	const char *command = PICK(commands);
+	static const char *const extras[] = { NULL, NULL, NULL, "\"seq\":42", "\"id\":\"gw-01\"" };
+
+	return formatCommand(out, size, command, PICK(nodeIDs), commandData(command), PICK(extras));
+}
+
+static int generateEscapes(char *out, size_t size)
+{
+	static const char *const data[] = {
+		"\\u0031", "O\\u004E", "line\\nbreak\\ttab", "quote \\\" and backslash \\\\", "25\\u00b0C",
+		"\\ud83d\\ude00", "a\\/b\\/c", "\\b\\f\\r"
+	};
+
+	return formatCommand(out, size, corpusRandom(2) ? "A\\u0043T" : "ACT", PICK(nodeIDs), PICK(data), NULL);
+}
+
+static int generateLarge(char *out, size_t size)
+{
+	char data[MESSAGE_MAX / 2 - 16];
+	size_t length = 64 + corpusRandom(sizeof(data) - 64), i;
+
+	for (i = 0; i < length; i++)
+		data[i] = (char)('a' + corpusRandom(26));
+	data[length] = '\0';
+	return formatCommand(out, size, "ACT", PICK(nodeIDs), data, NULL);
+}
+
+// The reports of sendNodeReading, sendNodeMessage and sendLinkStatus
+static int generateReport(char *out, size_t size)
+{
+	static const char *const texts[] = { "DONE", "ERROR", "COBS1" };
+
+	switch (corpusRandom(4)) {
+	case 0:
+		return snprintf(out, size, "{\"nodeType\":\"NS\",\"nodeID\":128,\"data\":\"%d\xc2\xb0" "C\"}", (int)corpusRandom(60));
+	case 1:
+		return snprintf(out, size, "{\"nodeType\":\"NS\",\"nodeID\":129,\"data\":\"%d\"}", (int)corpusRandom(4096));
+	case 2:
+		return snprintf(out, size, "{\"nodeType\":\"%s\",\"nodeID\":%d,\"data\":\"%s\"}",
+				corpusRandom(2) ? "NA" : "SYS", PICK(nodeIDs), PICK(texts));
+	default:
+		return snprintf(out, size, "{\"nodeType\":\"SYS\",\"nodeID\":0,\"data\":{\"ORE\":%u,\"FE\":%u,\"NE\":0,\"PE\":0,"
+				"\"OVW\":%u,\"LAT_CYC\":%u,\"LATMAX_CYC\":%u}}",
+				corpusRandom(5), corpusRandom(3), corpusRandom(2), 2000 + corpusRandom(30000), 40000 + corpusRandom(9000));
+	}
+}
+
+static int generateMalformed(char *out, size_t size)
+{
+	static const char *const frames[] = {
+		"{\"command\":\"ENA\",\"nodeID\":}",
+		"{\"command\":\"ENA\" \"nodeID\":128}",
+		"{\"command\":\"ACT\",\"nodeID\":80,\"data\":\"1}",
+		"{\"command\":\"ACT\",\"nodeID\":80,\"data\":\"\\x\"}",
+		"{\"command\":\"STA\",\"nodeID\":128,}",
+		"{\"command\":\"STA\",\"nodeID\":12 8}",
+		"{\"command\":\"DIS\",\"nodeID\":-}",
+		"{\"command\":\"ENA\",\"nodeID\":128]",
+		"\"command\":\"ENA\",\"nodeID\":128}",
+		"{\"command\":\"ENA\",\"nodeID\":128}}"
+	};
+
+	return snprintf(out, size, "%s", PICK(frames));
+}
+
+size_t corpusGenerate(CorpusMessage *messages, size_t count, unsigned long seed)
+{
+	// weights of the kinds, out of 20
+	static const CorpusKind mix[20] = {
+		CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND,
+		CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND, CORPUS_COMMAND,
+		CORPUS_REPORT, CORPUS_REPORT, CORPUS_REPORT, CORPUS_REPORT,
+		CORPUS_ESCAPES, CORPUS_ESCAPES,
+		CORPUS_LARGE,
+		CORPUS_MALFORMED, CORPUS_MALFORMED, CORPUS_MALFORMED
+	};
+	char text[MESSAGE_MAX];
+	size_t i;
+
+	corpusState = seed;
+	for (i = 0; i < count; i++) {
+		CorpusKind kind = mix[corpusRandom(20)];
+		int length = 0;
+
+		switch (kind) {
+		case CORPUS_COMMAND:   length = generateCommand(text, sizeof(text)); break;
+		case CORPUS_ESCAPES:   length = generateEscapes(text, sizeof(text)); break;
+		case CORPUS_LARGE:     length = generateLarge(text, sizeof(text)); break;
+		case CORPUS_REPORT:    length = generateReport(text, sizeof(text)); break;
+		default:               length = generateMalformed(text, sizeof(text)); break;
+		}
+
+		messages[i].text = malloc((size_t)length + 1);
+		if (messages[i].text == NULL)
+			break;
+		memcpy(messages[i].text, text, (size_t)length + 1);
+		messages[i].length = (size_t)length;
+		messages[i].kind = kind;
+	}
+	return i;
+}
+
+void corpusFree(CorpusMessage *messages, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		free(messages[i].text);
+}
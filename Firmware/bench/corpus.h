@@ -0,0 +1,33 @@
+/*
+ * corpus.h
+ *
+ * Generated corpus of the messages the firmware exchanges, for the host benchmarks.
+ */
+
+#ifndef CORPUS_H_
+#define CORPUS_H_
+
+#include <stddef.h>
+
+typedef enum {
+	CORPUS_COMMAND,   // command of the gateway, every command type, varied member order and whitespace
+	CORPUS_ESCAPES,   // command whose strings use escape sequences
+	CORPUS_LARGE,     // command with a large data payload
+	CORPUS_REPORT,    // report of a node (reading, text or link counters)
+	CORPUS_MALFORMED, // broken frame that has to be rejected
+	CORPUS_KINDS
+} CorpusKind;
+
+typedef struct {
+	char *text;      // NUL terminated
+	size_t length;   // without the NUL
+	CorpusKind kind;
+} CorpusMessage;
+
+extern const char *const corpusKindNames[CORPUS_KINDS];
+
+// Generate count messages, the same ones for the same seed. Returns the number generated.
+size_t corpusGenerate(CorpusMessage *messages, size_t count, unsigned long seed);
+void corpusFree(CorpusMessage *messages, size_t count);
+
+#endif /* CORPUS_H_ */
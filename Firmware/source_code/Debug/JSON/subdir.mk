@@ -4,16 +4,26 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../JSON/cJSON.c 
+../JSON/cJSON.c \
+../JSON/cJSON_Push.c \
+../JSON/cJSON_Writer.c 
 
 OBJS += \
-./JSON/cJSON.o 
+./JSON/cJSON.o \
+./JSON/cJSON_Push.o \
+./JSON/cJSON_Writer.o 
 
 C_DEPS += \
-./JSON/cJSON.d 
+./JSON/cJSON.d \
+./JSON/cJSON_Push.d \
+./JSON/cJSON_Writer.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 JSON/cJSON.o: ../JSON/cJSON.c
 	arm-none-eabi-gcc "$<" -mcpu=cortex-m3 -std=gnu11 -g3 -DSTM32 -DSTM32F1 -DSTM32F103C6Tx -DDEBUG -c -I"F:/Mostafa/smart_egat_task/STM32F103C6_DRIVERS/inc" -I../Inc -I"F:/Mostafa/smart_egat_task/JSON/includes" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/include" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/portable/GCC/ARM_CM3" -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -MMD -MP -MF"JSON/cJSON.d" -MT"$@" --specs=nano.specs -mfloat-abi=soft -mthumb -o "$@"
+JSON/cJSON_Push.o: ../JSON/cJSON_Push.c
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m3 -std=gnu11 -g3 -DSTM32 -DSTM32F1 -DSTM32F103C6Tx -DDEBUG -c -I"F:/Mostafa/smart_egat_task/STM32F103C6_DRIVERS/inc" -I../Inc -I"F:/Mostafa/smart_egat_task/JSON/includes" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/include" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/portable/GCC/ARM_CM3" -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -MMD -MP -MF"JSON/cJSON_Push.d" -MT"$@" --specs=nano.specs -mfloat-abi=soft -mthumb -o "$@"
+JSON/cJSON_Writer.o: ../JSON/cJSON_Writer.c
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m3 -std=gnu11 -g3 -DSTM32 -DSTM32F1 -DSTM32F103C6Tx -DDEBUG -c -I"F:/Mostafa/smart_egat_task/STM32F103C6_DRIVERS/inc" -I../Inc -I"F:/Mostafa/smart_egat_task/JSON/includes" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/include" -I"F:/Mostafa/smart_egat_task/FREE_RTOS/portable/GCC/ARM_CM3" -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -MMD -MP -MF"JSON/cJSON_Writer.d" -MT"$@" --specs=nano.specs -mfloat-abi=soft -mthumb -o "$@"
 
@@ -24,6 +24,7 @@ FREE_RTOS/portable/GCC/ARM_CM3 \
 FREE_RTOS/portable/MemMang \
 JSON \
 STM32F103C6_DRIVERS/ADC \
+STM32F103C6_DRIVERS/DMA \
 STM32F103C6_DRIVERS/EXTI \
 STM32F103C6_DRIVERS/GPIO \
 STM32F103C6_DRIVERS/I2C \
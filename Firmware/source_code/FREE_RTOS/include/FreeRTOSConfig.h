@@ -52,6 +52,7 @@
 #define configUSE_TRACE_FACILITY	0
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
+#define configUSE_MUTEXES			1
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Binary framing of the command link: a frame is a type byte, a payload and a
+ * CRC16 (CCITT, big endian), COBS encoded so that 0x00 only ends frames.
+ ******************************************************************************
+ */
+
+#ifndef COBS_FRAME_H_
+#define COBS_FRAME_H_
+
+#include <stdint.h>
+
+#define COBS_FRAME_MAX_PAYLOAD 40 // Longest payload of a frame
+#define COBS_FRAME_MAX_DECODED (1 + COBS_FRAME_MAX_PAYLOAD + 2) // Type, payload and CRC
+#define COBS_FRAME_MAX_ENCODED (COBS_FRAME_MAX_DECODED + 2) // One COBS code byte (frames are shorter than 254 bytes) and the delimiter
+#define COBS_FRAME_CRC_INIT 0xFFFF // Start value of crc16Ccitt
+
+// Result of feeding one received byte to the decoder
+typedef enum {
+	COBS_FRAME_NONE,  // The frame is not complete yet (or was empty)
+	COBS_FRAME_OK,    // A frame with a good CRC ended, see cobsFrameType/cobsFramePayload
+	COBS_FRAME_ERROR  // A frame was too long, truncated or had a bad CRC
+} CobsFrameResult;
+
+// Streaming decoder, bytes are decoded as they arrive
+typedef struct {
+	uint8_t data[COBS_FRAME_MAX_DECODED]; // Decoded type, payload and CRC
+	uint16_t length;   // Decoded bytes so far
+	uint8_t code;      // COBS code of the current block, 0 before the first one
+	uint8_t remaining; // Bytes left in the current block
+} CobsDecoder;
+
+// Fields of the frame that was just decoded
+#define cobsFrameType(decoder) ((decoder)->data[0])
+#define cobsFramePayload(decoder) (&(decoder)->data[1])
+#define cobsFramePayloadLength(decoder) ((uint16_t)((decoder)->length - 3))
+
+uint16_t crc16Ccitt(uint16_t crc, const uint8_t *data, uint16_t length);
+uint16_t cobsEncodeFrame(uint8_t type, const uint8_t *payload, uint16_t length, uint8_t *out);
+void cobsDecoderInit(CobsDecoder *decoder);
+CobsFrameResult cobsDecoderPush(CobsDecoder *decoder, uint8_t byte);
+
+#endif /* COBS_FRAME_H_ */
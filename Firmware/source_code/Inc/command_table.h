@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Command dispatcher: the 3 letter command is turned into a CommandCode by a
+ * perfect hash when it is decoded, the handler is then taken from a table
+ * indexed by the command code and the type of the node the command is for.
+ ******************************************************************************
+ */
+
+#ifndef COMMAND_TABLE_H_
+#define COMMAND_TABLE_H_
+
+#include <stdint.h>
+#include "node_registry.h"
+
+// Command codes, in the order of the binary command types (type = code + 1)
+typedef enum {
+	CMD_ENA,
+	CMD_DIS,
+	CMD_ACT,
+	CMD_STA,
+	CMD_DUR,
+	CMD_BAU,
+	CMD_LNK,
+	CMD_ABD,
+	CMD_BIN,
+	CMD_JSN,
+	CMD_COUNT,
+	CMD_UNKNOWN = 0xFF
+} CommandCode;
+
+// Structure to represent JSON message data, including command, node ID, and data payload
+typedef struct {
+	char command[64];    // Command to be executed by the system
+	int nodeID;          // Unique identifier for the node (sensor/actuator)
+	char data[32];       // Additional data associated with the command
+	uint8_t commandCode; // CommandCode of command, set by the decoder
+	uint32_t frameEndCycles; // DWT cycle count when the byte ending the command was received, set by the decoder
+} JsonMessage;
+
+// Perfect hash of the command names into COMMAND_HASH_SIZE slots, a constant expression for constant letters
+#define COMMAND_HASH_SIZE 16
+#define COMMAND_HASH(c0, c1, c2) (((((uint8_t)(c0)) * 5 + ((uint8_t)(c1)) * 2 + ((uint8_t)(c2))) >> 1) & (COMMAND_HASH_SIZE - 1))
+
+// Handler of a command for one type of node, slot is the registry slot of the node (NODE_NOT_FOUND for NODE_TYPE_NONE)
+typedef void (*CommandHandler)(const JsonMessage *jsonMsg, uint8_t slot);
+
+typedef struct {
+	CommandHandler handler; // NULL: the command is ignored for this node
+	const char *doneType;   // Node type of the "DONE" reply sent before the handler runs, NULL for none
+} CommandEntry;
+
+extern const char commandNames[CMD_COUNT][4];
+
+uint8_t commandCodeOf(const char *command);
+const CommandEntry *commandLookup(uint8_t commandCode, int nodeID);
+void dispatchCommand(const JsonMessage *jsonMsg);
+
+// Provided by the application
+void sendNodeMessage(const char *nodeType, int nodeID, const char *data, uint16_t dataLength); // data: NODE_TEXT("...")
+void enableSensor(const JsonMessage *jsonMsg, uint8_t slot);
+void enableActuator(const JsonMessage *jsonMsg, uint8_t slot);
+void disableSensor(const JsonMessage *jsonMsg, uint8_t slot);
+void disableActuator(const JsonMessage *jsonMsg, uint8_t slot);
+void setActuator(const JsonMessage *jsonMsg, uint8_t slot);
+void reportNodeStatus(const JsonMessage *jsonMsg, uint8_t slot);
+void setSensorPeriod(const JsonMessage *jsonMsg, uint8_t slot);
+void setBaudRate(const JsonMessage *jsonMsg, uint8_t slot);
+void reportLinkStatus(const JsonMessage *jsonMsg, uint8_t slot);
+void detectBaudRate(const JsonMessage *jsonMsg, uint8_t slot);
+void selectBinaryFraming(const JsonMessage *jsonMsg, uint8_t slot);
+void selectJsonFraming(const JsonMessage *jsonMsg, uint8_t slot);
+
+#endif /* COMMAND_TABLE_H_ */
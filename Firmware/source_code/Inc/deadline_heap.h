@@ -0,0 +1,32 @@
+/******************************************************************************
+ * Min-heap of the next reading times of the sensor nodes, the earliest one
+ * is on top. Times are tick counts, compared so that they may wrap around.
+ ******************************************************************************
+ */
+
+#ifndef DEADLINE_HEAP_H_
+#define DEADLINE_HEAP_H_
+
+#include <stdint.h>
+#include "node_registry.h"
+
+typedef struct {
+	uint32_t due; // Tick count of the next reading
+	uint8_t slot; // Registry slot of the node
+} Deadline;
+
+// Fixed size, one entry per node the registry can hold
+typedef struct {
+	Deadline entries[NODE_MAX];
+	uint8_t count;
+} DeadlineHeap;
+
+// Nonzero when tick count a comes before b (valid while they are less than 2^31 ticks apart)
+#define DEADLINE_BEFORE(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+void deadlineHeapInit(DeadlineHeap *heap);
+uint8_t deadlineHeapPush(DeadlineHeap *heap, uint8_t slot, uint32_t due);
+const Deadline *deadlineHeapTop(const DeadlineHeap *heap);
+void deadlineHeapPop(DeadlineHeap *heap);
+
+#endif /* DEADLINE_HEAP_H_ */
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Node registry: the sensors and actuators are described by a table of
+ * NodeConfig (flash) with one NodeState each (RAM), node IDs are found
+ * through a small hash index.
+ ******************************************************************************
+ */
+
+#ifndef NODE_REGISTRY_H_
+#define NODE_REGISTRY_H_
+
+#include <stdint.h>
+
+#define NODE_MAX 16 // Nodes the registry can hold
+#define NODE_INDEX_SIZE 32 // Slots of the ID index, a power of two at least twice NODE_MAX
+#define NODE_NOT_FOUND 0xFF
+#define NODE_STATE_MAX_BYTES 20 // Budget of a NodeState in bytes, a compile-time check; the real RAM is in the .map file
+#define NODE_OUTPUT_UNKNOWN 0xFF // NodeState output of an actuator that has not been written since it was powered up
+
+// A string literal followed by its length, for the units of the NodeConfig table and the text reports
+#define NODE_TEXT(text) (text), (sizeof(text) - 1)
+
+typedef enum {
+	NODE_TYPE_SENSOR,   // Sampled periodically, reported as "NS"
+	NODE_TYPE_ACTUATOR, // Driven by the ACT command, reported as "NA"
+	NODE_TYPE_NONE,     // Node ID that is not registered
+	NODE_TYPE_COUNT
+} NodeType;
+
+typedef struct NodeConfig NodeConfig;
+
+// Driver of a kind of node, the NodeConfig tells which device, port and pin it uses
+typedef struct {
+	void (*enable)(const NodeConfig *config);
+	void (*disable)(const NodeConfig *config);
+	uint8_t (*read)(const NodeConfig *config, int *value); // Sensors: sample, 0 if the sensor is not ready
+	void (*write)(const NodeConfig *config, int value);    // Actuators: drive the output
+} NodeOps;
+
+// Description of a node, kept in flash
+struct NodeConfig {
+	uint8_t id;           // Node ID of the commands and reports
+	uint8_t type;         // NodeType
+	const NodeOps *ops;
+	uint8_t device;       // Sensors: ADC number (1, 2)
+	uint8_t port;         // ADC input port (PA, PB) or GPIO port of an actuator
+	uint8_t pin;
+	uint8_t period;       // Seconds between readings after reset
+	const char *unit;     // Appended to the readings
+	uint8_t unitLength;   // strlen(unit), set with NODE_TEXT
+};
+
+// Runtime state of a node
+typedef struct {
+	int value;        // Last reading, or the output of an actuator
+	int savedValue;   // Output of an actuator while it is disabled
+	uint32_t nextDue; // Sensors: tick count of the next reading, kept by the sampler
+	uint16_t period;  // Seconds between readings
+	volatile uint8_t active; // Sensors: readings are on (DUR starts them, DIS stops them)
+	uint8_t scheduled; // Sensors: the sampler has the node in its deadline heap
+	volatile uint8_t powered; // The node should be powered up (ENA powers it up, DIS down)
+	uint8_t poweredOn; // The node is powered up, kept by the task that drives the node
+	uint8_t output; // Actuators: level last written to the pin, kept by the actuator task
+} NodeState;
+
+uint8_t nodeRegistryInit(const NodeConfig *configs, NodeState *states, uint8_t count);
+uint8_t nodeRegistryCount(void);
+uint8_t nodeFind(int nodeID);
+NodeType nodeTypeOf(int nodeID);
+const NodeConfig *nodeConfig(uint8_t slot);
+NodeState *nodeState(uint8_t slot);
+
+#endif /* NODE_REGISTRY_H_ */
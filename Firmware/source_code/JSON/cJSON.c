@@ -183,7 +183,152 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 /* strlen of character literals resolved at compile time */
 #define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
 
+#ifdef CJSON_POOL
+/* Free slots are linked through their own memory. Slots past the 'fresh' index were never handed out,
+ * so the pools need no initialisation. */
+typedef union pool_node
+{
+    union pool_node *next;
+    cJSON item;
+} pool_node;
+
+typedef union pool_string
+{
+    union pool_string *next;
+    unsigned char bytes[CJSON_POOL_STRING_SIZE];
+} pool_string;
+
+static pool_node pool_nodes[CJSON_POOL_NODES];
+static pool_string pool_strings[CJSON_POOL_STRINGS];
+
+static struct
+{
+    pool_node *free_nodes;
+    size_t fresh_nodes;
+    pool_string *free_strings;
+    size_t fresh_strings;
+    cJSON_PoolStats stats;
+} pool;
+
+static void *take_node(void)
+{
+    pool_node *node = NULL;
+
+    if (pool.free_nodes != NULL)
+    {
+        node = pool.free_nodes;
+        pool.free_nodes = node->next;
+    }
+    else if (pool.fresh_nodes < CJSON_POOL_NODES)
+    {
+        node = &pool_nodes[pool.fresh_nodes++];
+    }
+    else
+    {
+        return NULL;
+    }
+
+    pool.stats.nodes_used++;
+    if (pool.stats.nodes_used > pool.stats.nodes_high_water_mark)
+    {
+        pool.stats.nodes_high_water_mark = pool.stats.nodes_used;
+    }
+
+    return node;
+}
+
+static void *take_string(void)
+{
+    pool_string *string = NULL;
+
+    if (pool.free_strings != NULL)
+    {
+        string = pool.free_strings;
+        pool.free_strings = string->next;
+    }
+    else if (pool.fresh_strings < CJSON_POOL_STRINGS)
+    {
+        string = &pool_strings[pool.fresh_strings++];
+    }
+    else
+    {
+        return NULL;
+    }
+
+    pool.stats.strings_used++;
+    if (pool.stats.strings_used > pool.stats.strings_high_water_mark)
+    {
+        pool.stats.strings_high_water_mark = pool.stats.strings_used;
+    }
+
+    return string;
+}
+
+static void * CJSON_CDECL pool_allocate(size_t size)
+{
+    void *memory = NULL;
+
+    /* smallest slot first, a short string may still use a node slot when the string pool is exhausted */
+    if ((size <= CJSON_POOL_STRING_SIZE) && ((memory = take_string()) != NULL))
+    {
+        return memory;
+    }
+    if ((size <= sizeof(cJSON)) && ((memory = take_node()) != NULL))
+    {
+        return memory;
+    }
+    if ((size <= CJSON_POOL_STRING_SIZE) || (size <= sizeof(cJSON)))
+    {
+        pool.stats.failures++;
+        return NULL;
+    }
+
+    pool.stats.heap_allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL pool_deallocate(void *pointer)
+{
+    const unsigned char *address = (const unsigned char*)pointer;
+
+    if (pointer == NULL)
+    {
+        return;
+    }
+
+    if ((address >= (const unsigned char*)pool_nodes) && (address < (const unsigned char*)(pool_nodes + CJSON_POOL_NODES)))
+    {
+        pool_node *node = (pool_node*)pointer;
+        node->next = pool.free_nodes;
+        pool.free_nodes = node;
+        pool.stats.nodes_used--;
+        return;
+    }
+    if ((address >= (const unsigned char*)pool_strings) && (address < (const unsigned char*)(pool_strings + CJSON_POOL_STRINGS)))
+    {
+        pool_string *string = (pool_string*)pointer;
+        string->next = pool.free_strings;
+        pool.free_strings = string;
+        pool.stats.strings_used--;
+        return;
+    }
+
+    free(pointer);
+}
+
+CJSON_PUBLIC(void) cJSON_GetPoolStats(cJSON_PoolStats *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = pool.stats;
+    }
+}
+
+/* there is no realloc for pool memory, printing falls back to allocate + copy */
+static internal_hooks global_hooks = { pool_allocate, pool_deallocate, NULL };
+#else
 static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
+#endif
 
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
@@ -211,9 +356,15 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
     if (hooks == NULL)
     {
         /* Reset hooks */
+#ifdef CJSON_POOL
+        global_hooks.allocate = pool_allocate;
+        global_hooks.deallocate = pool_deallocate;
+        global_hooks.reallocate = NULL;
+#else
         global_hooks.allocate = malloc;
         global_hooks.deallocate = free;
         global_hooks.reallocate = realloc;
+#endif
         return;
     }
 
@@ -270,6 +421,13 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
             global_hooks.deallocate(item->string);
             item->string = NULL;
         }
+#ifdef CJSON_INDEX
+        if (!(item->type & cJSON_IsReference) && (item->index != NULL))
+        {
+            global_hooks.deallocate(item->index);
+            item->index = NULL;
+        }
+#endif
         global_hooks.deallocate(item);
         item = next;
     }
@@ -293,8 +451,250 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+#ifdef CJSON_ARENA
+    cJSON_Arena *arena; /* if not NULL, all allocations of this parse are served by the arena */
+#endif
+#ifdef CJSON_IN_SITU
+    cJSON_bool in_situ; /* strings are unescaped in place and referenced instead of copied */
+#endif
 } parse_buffer;
 
+#ifdef CJSON_IN_SITU
+#define parse_in_situ(buffer) ((buffer)->in_situ)
+#else
+#define parse_in_situ(buffer) false
+#endif
+
+#ifdef CJSON_ARENA
+/* arena allocations start at addresses that are a multiple of this, so that the doubles inside cJSON nodes
+ * are aligned (Cortex-M3 loads and stores doubles with LDRD/STRD, which fault on unaligned addresses) */
+#define CJSON_ARENA_ALIGNMENT sizeof(double)
+
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena *arena, void *buffer, size_t size)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->buffer = (unsigned char*)buffer;
+    arena->size = (buffer != NULL) ? size : 0;
+    arena->offset = 0;
+    arena->high_water_mark = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    if (arena != NULL)
+    {
+        arena->offset = 0;
+    }
+}
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    /* align the address rather than the offset, the caller's buffer may start anywhere */
+    size_t padding = (size_t)(0U - (size_t)(arena->buffer + arena->offset)) & (CJSON_ARENA_ALIGNMENT - 1);
+    size_t start = arena->offset + padding;
+
+    if ((padding > (arena->size - arena->offset)) || (size > (arena->size - start)))
+    {
+        return NULL; /* arena exhausted */
+    }
+
+    arena->offset = start + size;
+    if (arena->offset > arena->high_water_mark)
+    {
+        arena->high_water_mark = arena->offset;
+    }
+
+    return arena->buffer + start;
+}
+
+/* allocation helpers used by the parser, they dispatch to the arena when one is attached */
+static void *parse_allocate(parse_buffer * const buffer, size_t size)
+{
+    if (buffer->arena != NULL)
+    {
+        return arena_allocate(buffer->arena, size);
+    }
+
+    return buffer->hooks.allocate(size);
+}
+
+static void parse_deallocate(parse_buffer * const buffer, void *pointer)
+{
+    /* arena memory is only released as a whole */
+    if (buffer->arena == NULL)
+    {
+        buffer->hooks.deallocate(pointer);
+    }
+}
+
+static cJSON *parse_new_item(parse_buffer * const buffer)
+{
+    cJSON *node = NULL;
+
+    if (buffer->arena == NULL)
+    {
+        return cJSON_New_Item(&buffer->hooks);
+    }
+
+    node = (cJSON*)arena_allocate(buffer->arena, sizeof(cJSON));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON));
+    }
+
+    return node;
+}
+
+static void parse_delete(parse_buffer * const buffer, cJSON *item)
+{
+    if (buffer->arena == NULL)
+    {
+        cJSON_Delete(item);
+    }
+}
+#else
+/* without arenas the parser allocates through the hooks */
+#define parse_allocate(buffer, size) ((buffer)->hooks.allocate(size))
+#define parse_deallocate(buffer, pointer) ((buffer)->hooks.deallocate(pointer))
+#define parse_new_item(buffer) cJSON_New_Item(&(buffer)->hooks)
+#define parse_delete(buffer, item) cJSON_Delete(item)
+#endif
+
+#ifdef CJSON_INDEX
+/* Open addressed hash table of the children of an object, keyed by their lower case names so that
+ * case sensitive and case insensitive lookups can share it. The table is at most half full and
+ * children are inserted in list order, so probing finds the first matching child like a list walk does. */
+struct cJSON_Index
+{
+    size_t mask; /* number of slots - 1, the number of slots is a power of two */
+    cJSON **slots;
+};
+
+static size_t index_hash(const unsigned char *name)
+{
+    /* FNV-1a */
+    size_t hash = (size_t)2166136261UL;
+    for (; *name != '\0'; name++)
+    {
+        hash ^= (size_t)tolower(*name);
+        hash *= (size_t)16777619UL;
+    }
+
+    return hash;
+}
+
+static size_t count_children(const cJSON * const object)
+{
+    const cJSON *child = NULL;
+    size_t count = 0;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/* number of slots needed to index 'count' children */
+static size_t index_capacity(const size_t count)
+{
+    size_t capacity = 4;
+    while (capacity < (count * 2))
+    {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+/* memory has room for the index and its slots */
+static struct cJSON_Index *fill_index(void *memory, const size_t capacity, const cJSON * const object)
+{
+    struct cJSON_Index *index = (struct cJSON_Index*)memory;
+    cJSON *child = NULL;
+
+    index->mask = capacity - 1;
+    index->slots = (cJSON**)(index + 1);
+    memset(index->slots, '\0', capacity * sizeof(cJSON*));
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        size_t position = 0;
+        if (child->string == NULL)
+        {
+            continue;
+        }
+
+        position = index_hash((const unsigned char*)child->string) & index->mask;
+        while (index->slots[position] != NULL)
+        {
+            position = (position + 1) & index->mask;
+        }
+        index->slots[position] = child;
+    }
+
+    return index;
+}
+
+static cJSON *index_lookup(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    size_t position = index_hash((const unsigned char*)name) & index->mask;
+
+    for (; index->slots[position] != NULL; position = (position + 1) & index->mask)
+    {
+        cJSON *candidate = index->slots[position];
+        if (case_sensitive ? (strcmp(name, candidate->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)candidate->string) == 0))
+        {
+            return candidate;
+        }
+    }
+
+    return NULL;
+}
+
+#ifdef CJSON_ARENA
+/* Trees in an arena can't be changed and are never passed to cJSON_Delete, so wide objects get their
+ * index right away, allocated from the arena as well. Lookups will never build one from the heap. */
+static cJSON_bool parse_index_object(parse_buffer * const buffer, cJSON * const object, const size_t count)
+{
+    size_t capacity = 0;
+    void *memory = NULL;
+
+    if ((buffer->arena == NULL) || (CJSON_INDEX_THRESHOLD == 0) || (count <= CJSON_INDEX_THRESHOLD))
+    {
+        return true;
+    }
+
+    capacity = index_capacity(count);
+    memory = arena_allocate(buffer->arena, sizeof(struct cJSON_Index) + (capacity * sizeof(cJSON*)));
+    if (memory == NULL)
+    {
+        return false;
+    }
+    object->index = fill_index(memory, capacity, object);
+
+    return true;
+}
+#endif
+
+/* drop the index of an object whose children change */
+static void invalidate_index(cJSON * const object)
+{
+    if ((object != NULL) && !(object->type & cJSON_IsReference) && (object->index != NULL))
+    {
+        global_hooks.deallocate(object->index);
+        object->index = NULL;
+    }
+}
+#else
+#define invalidate_index(object)
+#endif
+
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
 #define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
 /* check if the buffer can be accessed at the given index (starting with 0) */
@@ -304,12 +704,68 @@ typedef struct
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
 /* Parse the input text to generate a number, and populate the result into item. */
+/* Parse a plain integer that fits an int without strtod and without floating point arithmetic.
+ * Returns false if the number has a fraction or exponent or is too long, it is then left to strtod. */
+static cJSON_bool parse_integer(cJSON * const item, parse_buffer * const input_buffer)
+{
+    size_t i = 0;
+    size_t digits = 0;
+    cJSON_bool negative = false;
+    int number = 0;
+
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '-'))
+    {
+        negative = true;
+        i++;
+    }
+
+    /* at most 9 digits, so the value can't overflow an int */
+    for (; can_access_at_index(input_buffer, i) && (buffer_at_offset(input_buffer)[i] >= '0') && (buffer_at_offset(input_buffer)[i] <= '9'); i++)
+    {
+        if (++digits > 9)
+        {
+            return false;
+        }
+        number = (number * 10) + (buffer_at_offset(input_buffer)[i] - '0');
+    }
+
+    if ((digits == 0) || (negative && (number == 0)))
+    {
+        return false; /* not a number or -0, let strtod decide */
+    }
+    if (can_access_at_index(input_buffer, i))
+    {
+        switch (buffer_at_offset(input_buffer)[i])
+        {
+            case '.':
+            case 'e':
+            case 'E':
+                return false; /* not an integer */
+
+            default:
+                break;
+        }
+    }
+
+    if (negative)
+    {
+        number = -number;
+    }
+
+    item->valueint = number;
+    item->valuedouble = (double)number;
+    item->type = cJSON_Number;
+
+    input_buffer->offset += i;
+    return true;
+}
+
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
     unsigned char *after_end = NULL;
     unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
+    unsigned char decimal_point = 0;
     size_t i = 0;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
@@ -317,6 +773,14 @@ static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_bu
         return false;
     }
 
+    /* integers are by far the most common numbers */
+    if (parse_integer(item, input_buffer))
+    {
+        return true;
+    }
+
+    decimal_point = get_decimal_point();
+
     /* copy the number into a temporary buffer and replace '.' with the decimal point
      * of the current locale (for strtod)
      * This also takes care of '\0' not necessarily being available for marking the end of the input */
@@ -561,6 +1025,36 @@ static cJSON_bool compare_double(double a, double b)
 }
 
 /* Render the number nicely from the given item into a string. */
+/* Print an int without stdio, returns the length. */
+static int print_integer(unsigned char * const buffer, const int number)
+{
+    unsigned char digits[10];
+    unsigned int magnitude = (unsigned int)number;
+    int length = 0;
+    int count = 0;
+
+    if (number < 0)
+    {
+        buffer[length++] = '-';
+        magnitude = 0U - magnitude;
+    }
+
+    do
+    {
+        digits[count++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    while (magnitude != 0);
+
+    while (count > 0)
+    {
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
 static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
 {
     unsigned char *output_pointer = NULL;
@@ -576,14 +1070,15 @@ static cJSON_bool print_number(const cJSON * const item, printbuffer * const out
         return false;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    /* integers first, NaN and Infinity never compare equal to one */
+    if (d == (double)item->valueint)
     {
-        length = sprintf((char*)number_buffer, "null");
+        length = print_integer(number_buffer, item->valueint);
     }
-    else if(d == (double)item->valueint)
+    /* This checks for NaN and Infinity */
+    else if (isnan(d) || isinf(d))
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        length = sprintf((char*)number_buffer, "null");
     }
     else
     {
@@ -788,6 +1283,75 @@ fail:
     return 0;
 }
 
+#ifdef CJSON_SWAR
+/* Build option: with CJSON_SWAR defined, whitespace and the bodies of strings are skipped a machine word
+ * (four bytes on 32 bit targets) at a time, testing all bytes of the word with a few integer operations.
+ * Once a word contains the byte being searched for (or less than a word is left) the kernels finish
+ * byte by byte, so they stop exactly where the byte loops would. */
+typedef unsigned long swar_word;
+
+#define SWAR_ONES (((swar_word)~(swar_word)0) / 0xFF) /* 0x01 in every byte */
+#define SWAR_HIGHS (SWAR_ONES * 0x80)
+/* non zero if any byte of word is zero */
+#define swar_has_zero(word) (((word) - SWAR_ONES) & ~(word) & SWAR_HIGHS)
+
+static swar_word swar_load(const unsigned char * const pointer)
+{
+    /* the input may be unaligned */
+    swar_word word = 0;
+    memcpy(&word, pointer, sizeof(word));
+
+    return word;
+}
+
+/* Number of leading whitespace bytes (<= 32 like buffer_skip_whitespace). */
+static size_t swar_skip_whitespace(const unsigned char * const input, const size_t length)
+{
+    size_t skipped = 0;
+
+    while ((length - skipped) >= sizeof(swar_word))
+    {
+        const swar_word word = swar_load(input + skipped);
+        /* the high bit of a byte is set if it is > 32, masking off the high bits first prevents carries */
+        if ((((word & ~SWAR_HIGHS) + (SWAR_ONES * (0x80 - 33))) | word) & SWAR_HIGHS)
+        {
+            break;
+        }
+        skipped += sizeof(swar_word);
+    }
+
+    while ((skipped < length) && (input[skipped] <= 32))
+    {
+        skipped++;
+    }
+
+    return skipped;
+}
+
+/* Number of leading bytes before the first quote or backslash. */
+static size_t swar_skip_string(const unsigned char * const input, const size_t length)
+{
+    size_t skipped = 0;
+
+    while ((length - skipped) >= sizeof(swar_word))
+    {
+        const swar_word word = swar_load(input + skipped);
+        if (swar_has_zero(word ^ (SWAR_ONES * '\"')) || swar_has_zero(word ^ (SWAR_ONES * '\\')))
+        {
+            break;
+        }
+        skipped += sizeof(swar_word);
+    }
+
+    while ((skipped < length) && (input[skipped] != '\"') && (input[skipped] != '\\'))
+    {
+        skipped++;
+    }
+
+    return skipped;
+}
+#endif
+
 /* Parse the input text into an unescaped cinput, and populate item. */
 static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -806,6 +1370,13 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
         /* calculate approximate size of the output (overestimate) */
         size_t allocation_length = 0;
         size_t skipped_bytes = 0;
+#ifdef CJSON_SWAR
+        /* jump to the first quote or backslash, escape sequences are rare enough for the byte loop */
+        if ((size_t)(input_end - input_buffer->content) < input_buffer->length)
+        {
+            input_end += swar_skip_string(input_end, input_buffer->length - (size_t)(input_end - input_buffer->content));
+        }
+#endif
         while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
         {
             /* is escape sequence */
@@ -826,16 +1397,40 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
             goto fail; /* string ended unexpectedly */
         }
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        if (parse_in_situ(input_buffer))
         {
-            goto fail; /* allocation failure */
+            /* unescaping never grows a string, so it can be written over its own source
+             * and terminated where the closing quote was */
+            output = (unsigned char*)input_pointer;
+            if (skipped_bytes == 0)
+            {
+                output_pointer = output + (input_end - input_pointer);
+                input_pointer = input_end;
+            }
+        }
+        else
+        {
+            /* This is at most how much we need for the output */
+            allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+            output = (unsigned char*)parse_allocate(input_buffer, allocation_length + sizeof(""));
+            if (output == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
+            if (skipped_bytes == 0)
+            {
+                /* nothing to unescape, copy the string as a whole */
+                memcpy(output, input_pointer, (size_t)(input_end - input_pointer));
+                output_pointer = output + (input_end - input_pointer);
+                input_pointer = input_end;
+            }
         }
     }
 
-    output_pointer = output;
+    if (output_pointer == NULL)
+    {
+        output_pointer = output;
+    }
     /* loop through the string literal */
     while (input_pointer < input_end)
     {
@@ -896,6 +1491,11 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     *output_pointer = '\0';
 
     item->type = cJSON_String;
+    if (parse_in_situ(input_buffer))
+    {
+        /* the string lives in the caller's buffer, cJSON_Delete must not free it */
+        item->type |= cJSON_IsReference;
+    }
     item->valuestring = (char*)output;
 
     input_buffer->offset = (size_t) (input_end - input_buffer->content);
@@ -904,9 +1504,9 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && !parse_in_situ(input_buffer))
     {
-        input_buffer->hooks.deallocate(output);
+        parse_deallocate(input_buffer, output);
         output = NULL;
     }
 
@@ -1067,6 +1667,14 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
         return buffer;
     }
 
+#ifdef CJSON_SWAR
+    /* most tokens are preceded by no or a single whitespace byte, don't bother for those */
+    if (can_access_at_index(buffer, 1) && (buffer_at_offset(buffer)[0] <= 32) && (buffer_at_offset(buffer)[1] <= 32))
+    {
+        buffer->offset += swar_skip_whitespace(buffer_at_offset(buffer), buffer->length - buffer->offset);
+    }
+#endif
+
     while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
     {
        buffer->offset++;
@@ -1111,11 +1719,13 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
     return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+/* Parse an object - create a new root, and populate. buffer comes zeroed, with the options of the parse set. */
+static cJSON *parse_with_length_opts(parse_buffer * const buffer, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
     cJSON *item = NULL;
+#ifdef CJSON_ARENA
+    size_t arena_mark = (buffer->arena != NULL) ? buffer->arena->offset : 0;
+#endif
 
     /* reset error position */
     global_error.json = NULL;
@@ -1126,18 +1736,18 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
         goto fail;
     }
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    buffer->content = (const unsigned char*)value;
+    buffer->length = buffer_length;
+    buffer->offset = 0;
+    buffer->hooks = global_hooks;
 
-    item = cJSON_New_Item(&global_hooks);
+    item = parse_new_item(buffer);
     if (item == NULL) /* memory fail */
     {
         goto fail;
     }
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(buffer))))
     {
         /* parse failure. ep is set. */
         goto fail;
@@ -1146,15 +1756,15 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
     if (require_null_terminated)
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        buffer_skip_whitespace(buffer);
+        if ((buffer->offset >= buffer->length) || buffer_at_offset(buffer)[0] != '\0')
         {
             goto fail;
         }
     }
     if (return_parse_end)
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        *return_parse_end = (const char*)buffer_at_offset(buffer);
     }
 
     return item;
@@ -1162,22 +1772,30 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
 fail:
     if (item != NULL)
     {
-        cJSON_Delete(item);
+        parse_delete(buffer, item);
     }
 
+#ifdef CJSON_ARENA
+    if (buffer->arena != NULL)
+    {
+        /* drop whatever the failed parse took from the arena */
+        buffer->arena->offset = arena_mark;
+    }
+#endif
+
     if (value != NULL)
     {
         error local_error;
         local_error.json = (const unsigned char*)value;
         local_error.position = 0;
 
-        if (buffer.offset < buffer.length)
+        if (buffer->offset < buffer->length)
         {
-            local_error.position = buffer.offset;
+            local_error.position = buffer->offset;
         }
-        else if (buffer.length > 0)
+        else if (buffer->length > 0)
         {
-            local_error.position = buffer.length - 1;
+            local_error.position = buffer->length - 1;
         }
 
         if (return_parse_end != NULL)
@@ -1191,6 +1809,50 @@ fail:
     return NULL;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    parse_buffer buffer;
+
+    memset(&buffer, '\0', sizeof(buffer));
+
+    return parse_with_length_opts(&buffer, value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+#ifdef CJSON_ARENA
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena)
+{
+    parse_buffer buffer;
+
+    if ((arena == NULL) || (arena->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.arena = arena;
+
+    return parse_with_length_opts(&buffer, value, buffer_length, return_parse_end, require_null_terminated);
+}
+#endif
+
+#ifdef CJSON_IN_SITU
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena)
+{
+    parse_buffer buffer;
+
+    if ((arena != NULL) && (arena->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.arena = arena;
+    buffer.in_situ = true;
+
+    return parse_with_length_opts(&buffer, value, buffer_length, return_parse_end, require_null_terminated);
+}
+#endif
+
 /* Default options for cJSON_Parse */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
 {
@@ -1500,7 +2162,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1553,7 +2215,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(input_buffer, head);
     }
 
     return false;
@@ -1626,6 +2288,9 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+#if defined(CJSON_INDEX) && defined(CJSON_ARENA)
+    size_t count = 0;
+#endif
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1658,11 +2323,14 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
         }
+#if defined(CJSON_INDEX) && defined(CJSON_ARENA)
+        count++;
+#endif
 
         /* attach next item to list */
         if (head == NULL)
@@ -1695,6 +2363,11 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* swap valuestring and string, because we parsed the name */
         current_item->string = current_item->valuestring;
         current_item->valuestring = NULL;
+        if (parse_in_situ(input_buffer))
+        {
+            /* the name points into the caller's buffer */
+            current_item->type = cJSON_StringIsConst;
+        }
 
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
@@ -1706,8 +2379,16 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         buffer_skip_whitespace(input_buffer);
         if (!parse_value(current_item, input_buffer))
         {
+            if (parse_in_situ(input_buffer))
+            {
+                current_item->type |= cJSON_StringIsConst;
+            }
             goto fail; /* failed to parse value */
         }
+        if (parse_in_situ(input_buffer))
+        {
+            current_item->type |= cJSON_StringIsConst;
+        }
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -1727,13 +2408,21 @@ success:
     item->type = cJSON_Object;
     item->child = head;
 
+#if defined(CJSON_INDEX) && defined(CJSON_ARENA)
+    if (!parse_index_object(input_buffer, item, count))
+    {
+        item->child = NULL;
+        goto fail; /* allocation failure */
+    }
+#endif
+
     input_buffer->offset++;
     return true;
 
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(input_buffer, head);
     }
 
     return false;
@@ -1906,15 +2595,67 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+#ifdef CJSON_INDEX
+static void* cast_away_const(const void* string);
+
+/* Index a wide object on its first lookup, returns NULL if it is too small (or out of memory). */
+static struct cJSON_Index *lazy_index(const cJSON * const object)
+{
+    cJSON *mutable_object = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    void *memory = NULL;
+
+    if ((CJSON_INDEX_THRESHOLD == 0) || (object->type & cJSON_IsReference) || ((object->type & 0xFF) != cJSON_Object))
+    {
+        return NULL;
+    }
+    if (object->index != NULL)
+    {
+        return object->index;
+    }
+
+    count = count_children(object);
+    if (count <= CJSON_INDEX_THRESHOLD)
+    {
+        return NULL;
+    }
+
+    capacity = index_capacity(count);
+    memory = global_hooks.allocate(sizeof(struct cJSON_Index) + (capacity * sizeof(cJSON*)));
+    if (memory == NULL)
+    {
+        return NULL;
+    }
+
+    /* the index is a cache, building it doesn't change the object */
+    mutable_object = (cJSON*)cast_away_const(object);
+    mutable_object->index = fill_index(memory, capacity, object);
+
+    return mutable_object->index;
+}
+#endif
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+#ifdef CJSON_INDEX
+    struct cJSON_Index *index = NULL;
+#endif
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+#ifdef CJSON_INDEX
+    index = lazy_index(object);
+    if (index != NULL)
+    {
+        return index_lookup(index, name, case_sensitive);
+    }
+#endif
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -1977,6 +2718,9 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+#ifdef CJSON_INDEX
+    reference->index = NULL;
+#endif
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -1991,6 +2735,8 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         return false;
     }
 
+    invalidate_index(array);
+
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2220,6 +2966,8 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    invalidate_index(parent);
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2309,6 +3057,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
+    invalidate_index(array);
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2335,6 +3085,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    invalidate_index(parent);
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
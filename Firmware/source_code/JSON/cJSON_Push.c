@@ -0,0 +1,990 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* cJSON_Push */
+/* Byte-at-a-time tokenizer for flat JSON objects, see cJSON_Push.h */
+
+#include <string.h>
+#include <limits.h>
+
+#include "cJSON_Push.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+#if CJSON_PUSH_NESTING_LIMIT > 32
+#error CJSON_PUSH_NESTING_LIMIT can be at most 32
+#endif
+#if (CJSON_PUSH_KEY_LENGTH > 255) || (CJSON_PUSH_VALUE_LENGTH > 255)
+#error CJSON_PUSH_KEY_LENGTH and CJSON_PUSH_VALUE_LENGTH can be at most 255
+#endif
+
+/* where the tokenizer is inside the top level object */
+enum
+{
+    push_idle,          /* waiting for '{' */
+    push_object_start,  /* after '{': a name or '}' */
+    push_key_start,     /* after ',': a name */
+    push_key,           /* inside a name */
+    push_colon,         /* after a name */
+    push_value_start,   /* after ':' */
+    push_value_string,
+    push_value_number,
+    push_value_literal, /* true, false or null */
+    push_value_nested,  /* skipping an object or array value */
+    push_member_end     /* after a value: ',' or '}' */
+};
+
+/* where the tokenizer is inside a string */
+enum
+{
+    string_normal,
+    string_escape,
+    string_hex1,
+    string_hex2,
+    string_hex3,
+    string_hex4,
+    string_low_backslash, /* expecting the \ of the second half of a surrogate pair */
+    string_low_u,         /* expecting the u of the second half of a surrogate pair */
+    string_skip           /* inside a string of a nested value, nothing is stored */
+};
+
+/* where the tokenizer is inside a number, following the JSON grammar */
+enum
+{
+    number_sign,     /* after '-' */
+    number_zero,     /* after a leading 0 */
+    number_integer,
+    number_point,    /* after '.' */
+    number_fraction,
+    number_exponent, /* after 'e' or 'E' */
+    number_exponent_sign,
+    number_exponent_digits
+};
+
+/* result of a single tokenizer step */
+enum
+{
+    step_consumed,
+    step_again, /* the byte terminated a token and has to be looked at again */
+    step_error
+};
+
+static const char * const literals[] = { "true", "false", "null" };
+
+static cJSON_bool is_whitespace(const unsigned char byte)
+{
+    return (byte == ' ') || (byte == '\t') || (byte == '\r') || (byte == '\n');
+}
+
+static void begin_object(cJSON_PushParser * const parser)
+{
+    parser->state = push_object_start;
+    parser->depth = 0;
+    parser->nesting = 0;
+}
+
+static void begin_member(cJSON_PushParser * const parser)
+{
+    parser->state = push_key;
+    parser->string_state = string_normal;
+    parser->high_surrogate = 0;
+    parser->type = cJSON_Invalid;
+    parser->key_length = 0;
+    parser->value_length = 0;
+    parser->truncated = 0;
+    parser->key[0] = '\0';
+    parser->value[0] = '\0';
+}
+
+static void raise_event(const cJSON_PushParser * const parser, const cJSON_PushEvent event)
+{
+    if (parser->callback != NULL)
+    {
+        parser->callback(parser, event, parser->user_data);
+    }
+}
+
+static unsigned char end_member(cJSON_PushParser * const parser)
+{
+    parser->value[parser->value_length] = '\0';
+    parser->state = push_member_end;
+    raise_event(parser, cJSON_PushMember);
+
+    return step_consumed;
+}
+
+/* append to the name or the value, whichever is being read, bytes past the maximum length are dropped
+ * and only flagged so the rest of the token is still checked and skipped */
+static cJSON_bool append(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    if (parser->state == push_key)
+    {
+        if (parser->key_length >= CJSON_PUSH_KEY_LENGTH)
+        {
+            parser->truncated |= cJSON_PushKeyTruncated;
+            return true;
+        }
+        parser->key[parser->key_length++] = (char)byte;
+        return true;
+    }
+
+    if (parser->value_length >= CJSON_PUSH_VALUE_LENGTH)
+    {
+        parser->truncated |= cJSON_PushValueTruncated;
+        return true;
+    }
+    parser->value[parser->value_length++] = (char)byte;
+
+    return true;
+}
+
+/* encode a code point as UTF-8 into the current string */
+static cJSON_bool append_utf8(cJSON_PushParser * const parser, const unsigned long codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        return append(parser, (unsigned char)codepoint);
+    }
+    if (codepoint < 0x800)
+    {
+        return append(parser, (unsigned char)(0xC0 | (codepoint >> 6)))
+            && append(parser, (unsigned char)(0x80 | (codepoint & 0x3F)));
+    }
+    if (codepoint < 0x10000)
+    {
+        return append(parser, (unsigned char)(0xE0 | (codepoint >> 12)))
+            && append(parser, (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F)))
+            && append(parser, (unsigned char)(0x80 | (codepoint & 0x3F)));
+    }
+
+    return append(parser, (unsigned char)(0xF0 | (codepoint >> 18)))
+        && append(parser, (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F)))
+        && append(parser, (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F)))
+        && append(parser, (unsigned char)(0x80 | (codepoint & 0x3F)));
+}
+
+static int hex_digit(const unsigned char byte)
+{
+    if ((byte >= '0') && (byte <= '9'))
+    {
+        return byte - '0';
+    }
+    if ((byte >= 'A') && (byte <= 'F'))
+    {
+        return 10 + byte - 'A';
+    }
+    if ((byte >= 'a') && (byte <= 'f'))
+    {
+        return 10 + byte - 'a';
+    }
+
+    return -1;
+}
+
+/* called after the fourth hex digit of a \uXXXX sequence */
+static cJSON_bool finish_utf16_literal(cJSON_PushParser * const parser)
+{
+    const unsigned short code = parser->codepoint;
+
+    parser->string_state = string_normal;
+
+    if (parser->high_surrogate != 0)
+    {
+        unsigned long codepoint = 0;
+        if ((code < 0xDC00) || (code > 0xDFFF))
+        {
+            return false; /* invalid second half of the surrogate pair */
+        }
+        codepoint = 0x10000 + ((((unsigned long)parser->high_surrogate & 0x3FF) << 10) | (code & 0x3FF));
+        parser->high_surrogate = 0;
+
+        return append_utf8(parser, codepoint);
+    }
+
+    if ((code >= 0xDC00) && (code <= 0xDFFF))
+    {
+        return false; /* second half without a first half */
+    }
+    if ((code >= 0xD800) && (code <= 0xDBFF))
+    {
+        parser->high_surrogate = code;
+        parser->string_state = string_low_backslash;
+        return true;
+    }
+
+    return append_utf8(parser, code);
+}
+
+/* Handle one byte of a name or string value, returns false on invalid input.
+ * *complete is set when the closing quote was consumed. */
+static cJSON_bool string_byte(cJSON_PushParser * const parser, const unsigned char byte, cJSON_bool * const complete)
+{
+    int digit = 0;
+
+    switch (parser->string_state)
+    {
+        case string_normal:
+            if (byte == '\"')
+            {
+                *complete = true;
+                return true;
+            }
+            if (byte == '\\')
+            {
+                parser->string_state = string_escape;
+                return true;
+            }
+            return append(parser, byte);
+
+        case string_escape:
+            parser->string_state = string_normal;
+            switch (byte)
+            {
+                case 'b':
+                    return append(parser, '\b');
+                case 'f':
+                    return append(parser, '\f');
+                case 'n':
+                    return append(parser, '\n');
+                case 'r':
+                    return append(parser, '\r');
+                case 't':
+                    return append(parser, '\t');
+                case '\"':
+                case '\\':
+                case '/':
+                    return append(parser, byte);
+                case 'u':
+                    parser->codepoint = 0;
+                    parser->string_state = string_hex1;
+                    return true;
+                default:
+                    return false;
+            }
+
+        case string_hex1:
+        case string_hex2:
+        case string_hex3:
+        case string_hex4:
+            digit = hex_digit(byte);
+            if (digit < 0)
+            {
+                return false;
+            }
+            parser->codepoint = (unsigned short)((parser->codepoint << 4) | (unsigned short)digit);
+            if (parser->string_state == string_hex4)
+            {
+                return finish_utf16_literal(parser);
+            }
+            parser->string_state++;
+            return true;
+
+        case string_low_backslash:
+            parser->string_state = string_low_u;
+            return byte == '\\';
+
+        case string_low_u:
+            parser->codepoint = 0;
+            parser->string_state = string_hex1;
+            return byte == 'u';
+
+        default:
+            return false;
+    }
+}
+
+/* Handle one byte of a number, the number is complete when a byte arrives that can't be part of it. */
+static unsigned char number_byte(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    const cJSON_bool digit = (byte >= '0') && (byte <= '9');
+    unsigned char next = parser->literal_position;
+
+    switch (parser->literal_position)
+    {
+        case number_sign:
+            next = (byte == '0') ? number_zero : (digit ? number_integer : 0xFF);
+            break;
+        case number_zero:
+        case number_integer:
+            if ((parser->literal_position == number_integer) && digit)
+            {
+                next = number_integer;
+            }
+            else if (byte == '.')
+            {
+                next = number_point;
+            }
+            else if ((byte == 'e') || (byte == 'E'))
+            {
+                next = number_exponent;
+            }
+            else
+            {
+                next = 0xFE; /* end of number */
+            }
+            break;
+        case number_point:
+            next = digit ? number_fraction : 0xFF;
+            break;
+        case number_fraction:
+            if (digit)
+            {
+                next = number_fraction;
+            }
+            else if ((byte == 'e') || (byte == 'E'))
+            {
+                next = number_exponent;
+            }
+            else
+            {
+                next = 0xFE;
+            }
+            break;
+        case number_exponent:
+            next = ((byte == '+') || (byte == '-')) ? number_exponent_sign : (digit ? number_exponent_digits : 0xFF);
+            break;
+        case number_exponent_sign:
+            next = digit ? number_exponent_digits : 0xFF;
+            break;
+        case number_exponent_digits:
+            next = digit ? number_exponent_digits : 0xFE;
+            break;
+        default:
+            next = 0xFF;
+            break;
+    }
+
+    if (next == 0xFF)
+    {
+        return step_error;
+    }
+    if (next == 0xFE)
+    {
+        end_member(parser);
+        return step_again;
+    }
+
+    parser->literal_position = next;
+
+    return append(parser, byte) ? step_consumed : step_error;
+}
+
+/* Handle one byte of a nested object/array value without storing it. */
+static unsigned char nested_byte(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    if (parser->string_state == string_skip)
+    {
+        if (byte == '\\')
+        {
+            parser->string_state = string_escape;
+        }
+        else if (byte == '\"')
+        {
+            parser->string_state = string_normal;
+        }
+        return step_consumed;
+    }
+    if (parser->string_state == string_escape)
+    {
+        parser->string_state = string_skip;
+        return step_consumed;
+    }
+
+    switch (byte)
+    {
+        case '\"':
+            parser->string_state = string_skip;
+            break;
+
+        case '{':
+        case '[':
+            if (parser->depth >= CJSON_PUSH_NESTING_LIMIT)
+            {
+                return step_error; /* too deeply nested */
+            }
+            if (byte == '{')
+            {
+                parser->nesting |= (1UL << parser->depth);
+            }
+            else
+            {
+                parser->nesting &= ~(1UL << parser->depth);
+            }
+            parser->depth++;
+            break;
+
+        case '}':
+        case ']':
+            parser->depth--;
+            if (((parser->nesting >> parser->depth) & 1UL) != (unsigned long)(byte == '}'))
+            {
+                return step_error; /* mismatched brackets */
+            }
+            if (parser->depth == 0)
+            {
+                return end_member(parser);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return step_consumed;
+}
+
+/* Start reading the value of a member. */
+static unsigned char value_start(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    if (is_whitespace(byte))
+    {
+        return step_consumed;
+    }
+
+    switch (byte)
+    {
+        case '\"':
+            parser->type = cJSON_String;
+            parser->string_state = string_normal;
+            parser->state = push_value_string;
+            return step_consumed;
+
+        case 't':
+        case 'f':
+        case 'n':
+            parser->type = (byte == 't') ? cJSON_True : ((byte == 'f') ? cJSON_False : cJSON_NULL);
+            parser->literal_position = 1;
+            parser->state = push_value_literal;
+            return append(parser, byte) ? step_consumed : step_error;
+
+        case '{':
+        case '[':
+            parser->type = (byte == '{') ? cJSON_Object : cJSON_Array;
+            parser->string_state = string_normal;
+            parser->depth = 0;
+            parser->state = push_value_nested;
+            return nested_byte(parser, byte);
+
+        default:
+            if ((byte == '-') || ((byte >= '0') && (byte <= '9')))
+            {
+                parser->type = cJSON_Number;
+                parser->literal_position = (byte == '-') ? number_sign : ((byte == '0') ? number_zero : number_integer);
+                parser->state = push_value_number;
+                return append(parser, byte) ? step_consumed : step_error;
+            }
+            return step_error;
+    }
+}
+
+static unsigned char step(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    cJSON_bool complete = false;
+
+    switch (parser->state)
+    {
+        case push_idle:
+            if (byte == '{')
+            {
+                begin_object(parser);
+            }
+            return step_consumed;
+
+        case push_object_start:
+        case push_key_start:
+            if (is_whitespace(byte))
+            {
+                return step_consumed;
+            }
+            if (byte == '\"')
+            {
+                begin_member(parser);
+                return step_consumed;
+            }
+            if ((byte == '}') && (parser->state == push_object_start))
+            {
+                parser->state = push_idle;
+                raise_event(parser, cJSON_PushObjectEnd);
+                return step_consumed;
+            }
+            return step_error;
+
+        case push_key:
+            if (!string_byte(parser, byte, &complete))
+            {
+                return step_error;
+            }
+            if (complete)
+            {
+                parser->key[parser->key_length] = '\0';
+                parser->state = push_colon;
+            }
+            return step_consumed;
+
+        case push_colon:
+            if (is_whitespace(byte))
+            {
+                return step_consumed;
+            }
+            if (byte == ':')
+            {
+                parser->state = push_value_start;
+                return step_consumed;
+            }
+            return step_error;
+
+        case push_value_start:
+            return value_start(parser, byte);
+
+        case push_value_string:
+            if (!string_byte(parser, byte, &complete))
+            {
+                return step_error;
+            }
+            return complete ? end_member(parser) : step_consumed;
+
+        case push_value_number:
+            return number_byte(parser, byte);
+
+        case push_value_literal:
+        {
+            const char *literal = literals[(parser->type == cJSON_True) ? 0 : ((parser->type == cJSON_False) ? 1 : 2)];
+            if ((unsigned char)literal[parser->literal_position] != byte)
+            {
+                return step_error;
+            }
+            if (!append(parser, byte))
+            {
+                return step_error;
+            }
+            parser->literal_position++;
+            return (literal[parser->literal_position] == '\0') ? end_member(parser) : step_consumed;
+        }
+
+        case push_value_nested:
+            return nested_byte(parser, byte);
+
+        case push_member_end:
+            if (is_whitespace(byte))
+            {
+                return step_consumed;
+            }
+            if (byte == ',')
+            {
+                parser->state = push_key_start;
+                return step_consumed;
+            }
+            if (byte == '}')
+            {
+                parser->state = push_idle;
+                raise_event(parser, cJSON_PushObjectEnd);
+                return step_consumed;
+            }
+            return step_error;
+
+        default:
+            return step_error;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_PushInit(cJSON_PushParser *parser, cJSON_PushCallback callback, void *user_data)
+{
+    if (parser == NULL)
+    {
+        return;
+    }
+
+    memset(parser, '\0', sizeof(cJSON_PushParser));
+    parser->callback = callback;
+    parser->user_data = user_data;
+    parser->state = push_idle;
+}
+
+CJSON_PUBLIC(void) cJSON_PushReset(cJSON_PushParser *parser)
+{
+    if (parser != NULL)
+    {
+        parser->state = push_idle;
+    }
+}
+
+/* Feed one byte to a valid parser. */
+static cJSON_bool push_byte(cJSON_PushParser * const parser, const unsigned char byte)
+{
+    unsigned char result = step(parser, byte);
+
+    if (result == step_again)
+    {
+        /* a number is only complete once the byte after it arrives */
+        result = step(parser, byte);
+    }
+
+    if (result == step_error)
+    {
+        parser->state = push_idle;
+        raise_event(parser, cJSON_PushError);
+
+        /* a '{' where it doesn't belong is most likely the start of the next object */
+        if (byte == '{')
+        {
+            begin_object(parser);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/* Append run bytes to the name or the value at once, bytes past the maximum length are dropped and flagged
+ * like append does. */
+static void append_run(cJSON_PushParser * const parser, const unsigned char * const bytes, const size_t run)
+{
+    size_t space = 0;
+    char *destination = NULL;
+    unsigned char *stored = NULL;
+
+    if (parser->state == push_key)
+    {
+        space = (size_t)(CJSON_PUSH_KEY_LENGTH - parser->key_length);
+        destination = parser->key + parser->key_length;
+        stored = &parser->key_length;
+    }
+    else
+    {
+        space = (size_t)(CJSON_PUSH_VALUE_LENGTH - parser->value_length);
+        destination = parser->value + parser->value_length;
+        stored = &parser->value_length;
+    }
+
+    if (run > space)
+    {
+        parser->truncated |= (parser->state == push_key) ? cJSON_PushKeyTruncated : cJSON_PushValueTruncated;
+        memcpy(destination, bytes, space);
+        *stored = (unsigned char)(*stored + space);
+    }
+    else
+    {
+        memcpy(destination, bytes, run);
+        *stored = (unsigned char)(*stored + run);
+    }
+}
+
+/* Store the bytes of a name or string value up to the next quote or backslash at once, returns how many
+ * were consumed. */
+static size_t string_run(cJSON_PushParser * const parser, const unsigned char * const bytes, const size_t length)
+{
+    size_t run = 0;
+
+    while ((run < length) && (bytes[run] != '\"') && (bytes[run] != '\\'))
+    {
+        run++;
+    }
+    append_run(parser, bytes, run);
+
+    return run;
+}
+
+/* Store the digits of an integer, fraction or exponent at once, returns how many were consumed. The byte
+ * after them still goes through number_byte, which ends the number or moves to its next part. */
+static size_t digit_run(cJSON_PushParser * const parser, const unsigned char * const bytes, const size_t length)
+{
+    size_t run = 0;
+
+    while ((run < length) && (bytes[run] >= '0') && (bytes[run] <= '9'))
+    {
+        run++;
+    }
+    append_run(parser, bytes, run);
+
+    return run;
+}
+
+/* Skip whitespace between tokens, returns how many bytes were skipped. */
+static size_t whitespace_run(const unsigned char * const bytes, const size_t length)
+{
+    size_t run = 0;
+
+    while ((run < length) && is_whitespace(bytes[run]))
+    {
+        run++;
+    }
+
+    return run;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PushByte(cJSON_PushParser *parser, unsigned char byte)
+{
+    if (parser == NULL)
+    {
+        return false;
+    }
+
+    parser->offset = 0;
+
+    return push_byte(parser, byte);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PushBytes(cJSON_PushParser *parser, const unsigned char *bytes, size_t length)
+{
+    cJSON_bool valid = true;
+    size_t offset = 0;
+
+    if ((parser == NULL) || ((bytes == NULL) && (length > 0)))
+    {
+        return false;
+    }
+
+    while (offset < length)
+    {
+        /* Runs of plain string bytes, digits, whitespace and the bytes between objects don't need the state
+         * machine. The byte that ends a run is fed to it right away. */
+        switch (parser->state)
+        {
+            case push_key:
+            case push_value_string:
+                if (parser->string_state == string_normal)
+                {
+                    offset += string_run(parser, bytes + offset, length - offset);
+
+                    /* the closing quote, as string_byte and step would handle it */
+                    if ((offset < length) && (bytes[offset] == '\"'))
+                    {
+                        if (parser->state == push_key)
+                        {
+                            parser->key[parser->key_length] = '\0';
+                            parser->state = push_colon;
+                        }
+                        else
+                        {
+                            parser->offset = offset;
+                            end_member(parser);
+                        }
+                        offset++;
+                        continue;
+                    }
+                }
+                break;
+
+            case push_value_number:
+                if ((parser->literal_position == number_integer) || (parser->literal_position == number_fraction)
+                    || (parser->literal_position == number_exponent_digits))
+                {
+                    offset += digit_run(parser, bytes + offset, length - offset);
+                }
+                break;
+
+            case push_object_start:
+            case push_key_start:
+            case push_colon:
+            case push_value_start:
+            case push_member_end:
+                offset += whitespace_run(bytes + offset, length - offset);
+                break;
+
+            case push_idle:
+            {
+                const unsigned char *brace = (const unsigned char*)memchr(bytes + offset, '{', length - offset);
+                offset = (brace == NULL) ? length : (size_t)(brace - bytes);
+                break;
+            }
+
+            default:
+                break;
+        }
+        if (offset >= length)
+        {
+            break;
+        }
+
+        parser->offset = offset;
+        if (!push_byte(parser, bytes[offset]))
+        {
+            valid = false;
+        }
+        offset++;
+    }
+
+    return valid;
+}
+
+CJSON_PUBLIC(void) cJSON_PushRecordInit(cJSON_PushRecord *record, const cJSON_PushField *fields, size_t field_count, void *target)
+{
+    if (record == NULL)
+    {
+        return;
+    }
+
+    record->fields = fields;
+    record->field_count = (field_count > CJSON_PUSH_FIELD_LIMIT) ? CJSON_PUSH_FIELD_LIMIT : field_count;
+    record->target = target;
+    record->present = 0;
+    record->errors = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_PushRecordReset(cJSON_PushRecord *record)
+{
+    if (record != NULL)
+    {
+        record->present = 0;
+        record->errors = 0;
+    }
+}
+
+/* Convert the text of an integer number, fails for fractions, exponents and values that don't fit an int. */
+static cJSON_bool integer_value(const char *text, int * const result)
+{
+    cJSON_bool negative = false;
+    unsigned long magnitude = 0;
+    unsigned long digit = 0;
+    const unsigned long limit = (unsigned long)INT_MAX + 1;
+
+    if (*text == '-')
+    {
+        negative = true;
+        text++;
+    }
+    if (*text == '\0')
+    {
+        return false;
+    }
+
+    for (; *text != '\0'; text++)
+    {
+        if ((*text < '0') || (*text > '9'))
+        {
+            return false;
+        }
+        digit = (unsigned long)(*text - '0');
+        if (magnitude > ((limit - digit) / 10))
+        {
+            return false; /* doesn't fit an int */
+        }
+        magnitude = (magnitude * 10) + digit;
+    }
+
+    if (negative)
+    {
+        *result = (magnitude == limit) ? INT_MIN : -(int)magnitude;
+        return true;
+    }
+    if (magnitude == limit)
+    {
+        return false;
+    }
+    *result = (int)magnitude;
+
+    return true;
+}
+
+static cJSON_bool store_field(const cJSON_PushField * const field, unsigned char * const destination, const cJSON_PushParser * const parser)
+{
+    int number = 0;
+
+    if (parser->type == cJSON_NULL)
+    {
+        memset(destination, '\0', field->size);
+        return true;
+    }
+
+    switch (field->type)
+    {
+        case cJSON_String:
+            if ((parser->type != cJSON_String) || ((size_t)parser->value_length >= field->size))
+            {
+                return false;
+            }
+            memcpy(destination, parser->value, (size_t)parser->value_length + 1);
+            return true;
+
+        case cJSON_Number:
+            if ((parser->type != cJSON_Number) || (field->size != sizeof(int)) || !integer_value(parser->value, &number))
+            {
+                return false;
+            }
+            memcpy(destination, &number, sizeof(int));
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/* Check whether the member's name is the name of a field. A truncated name matches every field that
+ * starts with it and is too long to have been kept whole. */
+static cJSON_bool field_matches(const cJSON_PushField * const field, const cJSON_PushParser * const parser)
+{
+    if (parser->truncated & cJSON_PushKeyTruncated)
+    {
+        return (strncmp(field->name, parser->key, parser->key_length) == 0) && (strlen(field->name) > parser->key_length);
+    }
+
+    return strcmp(field->name, parser->key) == 0;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PushRecordMember(cJSON_PushRecord *record, const cJSON_PushParser *parser)
+{
+    size_t index = 0;
+
+    if ((record == NULL) || (parser == NULL) || (record->fields == NULL) || (record->target == NULL))
+    {
+        return false;
+    }
+
+    for (index = 0; index < record->field_count; index++)
+    {
+        const cJSON_PushField *field = &record->fields[index];
+        if (!field_matches(field, parser))
+        {
+            continue;
+        }
+
+        if ((parser->truncated != 0) || !store_field(field, (unsigned char*)record->target + field->offset, parser))
+        {
+            record->errors |= (1UL << index);
+            return false;
+        }
+        record->present |= (1UL << index);
+        return true;
+    }
+
+    /* not part of the schema */
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PushRecordComplete(const cJSON_PushRecord *record, unsigned long required)
+{
+    if (record == NULL)
+    {
+        return false;
+    }
+
+    return (record->errors == 0) && ((record->present & required) == required);
+}
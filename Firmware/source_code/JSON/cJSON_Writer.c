@@ -0,0 +1,289 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* cJSON_Writer */
+/* Streaming JSON writer, see cJSON_Writer.h */
+
+#include <string.h>
+
+#include "cJSON_Writer.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+#if CJSON_WRITER_NESTING_LIMIT > 32
+#error CJSON_WRITER_NESTING_LIMIT can be at most 32
+#endif
+
+static void emit(const cJSON_Writer * const writer, const unsigned char *data, const size_t length)
+{
+    if ((writer->sink != NULL) && (length > 0))
+    {
+        writer->sink(data, length, writer->user_data);
+    }
+}
+
+static void emit_byte(const cJSON_Writer * const writer, const unsigned char byte)
+{
+    emit(writer, &byte, 1);
+}
+
+/* Write the characters of a string without the quotes, runs that need no escaping are passed on as a whole. */
+static void emit_escaped(const cJSON_Writer * const writer, const unsigned char *string)
+{
+    static const unsigned char hex[] = "0123456789abcdef";
+    const unsigned char *run = string;
+    unsigned char escape[6] = { '\\', 'u', '0', '0', 0, 0 };
+
+    if (string == NULL)
+    {
+        return;
+    }
+
+    for (; *string != '\0'; string++)
+    {
+        size_t escape_length = 2;
+
+        if ((*string >= 32) && (*string != '\"') && (*string != '\\'))
+        {
+            continue;
+        }
+
+        emit(writer, run, (size_t)(string - run));
+        run = string + 1;
+
+        switch (*string)
+        {
+            case '\"':
+            case '\\':
+                escape[1] = *string;
+                break;
+            case '\b':
+                escape[1] = 'b';
+                break;
+            case '\f':
+                escape[1] = 'f';
+                break;
+            case '\n':
+                escape[1] = 'n';
+                break;
+            case '\r':
+                escape[1] = 'r';
+                break;
+            case '\t':
+                escape[1] = 't';
+                break;
+            default:
+                /* other control characters as \u00XX */
+                escape[1] = 'u';
+                escape[4] = hex[*string >> 4];
+                escape[5] = hex[*string & 0x0F];
+                escape_length = 6;
+                break;
+        }
+        emit(writer, escape, escape_length);
+    }
+
+    emit(writer, run, (size_t)(string - run));
+}
+
+static void emit_int(const cJSON_Writer * const writer, const int number)
+{
+    unsigned char digits[11];
+    unsigned int magnitude = (unsigned int)number;
+    size_t position = sizeof(digits);
+
+    if (number < 0)
+    {
+        magnitude = 0U - magnitude;
+    }
+
+    do
+    {
+        digits[--position] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    while (magnitude != 0);
+
+    if (number < 0)
+    {
+        digits[--position] = '-';
+    }
+
+    emit(writer, digits + position, sizeof(digits) - position);
+}
+
+CJSON_PUBLIC(void) cJSON_WriterInit(cJSON_Writer *writer, cJSON_WriterSink sink, void *user_data)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    writer->sink = sink;
+    writer->user_data = user_data;
+    writer->depth = 0;
+    writer->has_members = 0;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginObject(cJSON_Writer *writer)
+{
+    if ((writer == NULL) || (writer->depth >= CJSON_WRITER_NESTING_LIMIT))
+    {
+        return false;
+    }
+
+    writer->has_members &= ~(1UL << writer->depth);
+    writer->depth++;
+    emit_byte(writer, '{');
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndObject(cJSON_Writer *writer)
+{
+    if ((writer == NULL) || (writer->depth == 0))
+    {
+        return false;
+    }
+
+    writer->depth--;
+    emit_byte(writer, '}');
+
+    return true;
+}
+
+CJSON_PUBLIC(void) cJSON_WriterKey(cJSON_Writer *writer, const char *name)
+{
+    unsigned long level = 0;
+
+    if ((writer == NULL) || (writer->depth == 0))
+    {
+        return;
+    }
+
+    level = 1UL << (writer->depth - 1);
+    if (writer->has_members & level)
+    {
+        emit_byte(writer, ',');
+    }
+    writer->has_members |= level;
+
+    emit_byte(writer, '\"');
+    emit_escaped(writer, (const unsigned char*)name);
+    emit(writer, (const unsigned char*)"\":", 2);
+}
+
+CJSON_PUBLIC(void) cJSON_WriterInt(cJSON_Writer *writer, int number)
+{
+    if (writer != NULL)
+    {
+        emit_int(writer, number);
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterString(cJSON_Writer *writer, const char *string)
+{
+    cJSON_WriterStringBegin(writer);
+    cJSON_WriterStringAppend(writer, string);
+    cJSON_WriterStringEnd(writer);
+}
+
+CJSON_PUBLIC(void) cJSON_WriterStringBegin(cJSON_Writer *writer)
+{
+    if (writer != NULL)
+    {
+        emit_byte(writer, '\"');
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterStringAppend(cJSON_Writer *writer, const char *string)
+{
+    if (writer != NULL)
+    {
+        emit_escaped(writer, (const unsigned char*)string);
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterStringAppendInt(cJSON_Writer *writer, int number)
+{
+    if (writer != NULL)
+    {
+        emit_int(writer, number);
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterStringEnd(cJSON_Writer *writer)
+{
+    if (writer != NULL)
+    {
+        emit_byte(writer, '\"');
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterBufferInit(cJSON_WriterBuffer *buffer, void *memory, size_t size)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    buffer->buffer = (unsigned char*)memory;
+    buffer->size = (memory != NULL) ? size : 0;
+    buffer->length = 0;
+    buffer->overflow = false;
+    if (buffer->size > 0)
+    {
+        buffer->buffer[0] = '\0';
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_WriterBufferSink(const unsigned char *data, size_t length, void *user_data)
+{
+    cJSON_WriterBuffer *buffer = (cJSON_WriterBuffer*)user_data;
+    size_t available = 0;
+
+    if ((buffer == NULL) || (buffer->size == 0))
+    {
+        return;
+    }
+
+    /* keep room for the terminating NUL */
+    available = buffer->size - 1 - buffer->length;
+    if (length > available)
+    {
+        length = available;
+        buffer->overflow = true;
+    }
+
+    memcpy(buffer->buffer + buffer->length, data, length);
+    buffer->length += length;
+    buffer->buffer[buffer->length] = '\0';
+}
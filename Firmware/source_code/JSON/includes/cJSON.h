@@ -120,6 +120,12 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+#ifdef CJSON_INDEX
+    /* Lookup index of a wide object, built on demand and dropped by the add/insert/detach/replace APIs.
+     * Don't rename children of an object directly, that leaves the index stale. */
+    struct cJSON_Index *index;
+#endif
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -143,6 +149,25 @@ typedef int cJSON_bool;
 #define CJSON_CIRCULAR_LIMIT 10000
 #endif
 
+/* Optional features, each one is built only when its macro is defined for every file that includes cJSON.h:
+ *   CJSON_ARENA    parse sessions that allocate from a caller supplied buffer (cJSON_ParseWithArena)
+ *   CJSON_IN_SITU  parsing that references strings in the input instead of copying them (implies CJSON_ARENA)
+ *   CJSON_INDEX    hash index for lookups in wide objects, adds a pointer to every cJSON
+ *   CJSON_POOL     default hooks backed by static node and string pools
+ *   CJSON_SWAR     whitespace and string scanning a word at a time
+ * Without them the library and sizeof(cJSON) are those of plain cJSON. */
+#if defined(CJSON_IN_SITU) && !defined(CJSON_ARENA)
+#define CJSON_ARENA
+#endif
+
+#ifdef CJSON_INDEX
+/* Objects with more children than this get a hash index on their first lookup by name,
+ * so looking up names in wide objects doesn't walk the whole child list. 0 disables the index. */
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 16
+#endif
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -158,6 +183,68 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+#ifdef CJSON_ARENA
+/* Bump allocator for parse sessions. Every node and string of a tree parsed with cJSON_ParseWithArena is carved
+ * out of the caller supplied buffer (any alignment, allocations are aligned inside it), so parsing never touches
+ * the heap hooks. The tree must NOT be passed to cJSON_Delete (or modified with the add/replace/delete APIs), it
+ * is released as a whole with cJSON_ResetArena. */
+typedef struct cJSON_Arena
+{
+    unsigned char *buffer;
+    size_t size;
+    size_t offset;
+    /* highest offset ever reached, useful to size the buffer from field data */
+    size_t high_water_mark;
+} cJSON_Arena;
+
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena *arena, void *buffer, size_t size);
+/* Release everything allocated from the arena in O(1). */
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+/* Same as cJSON_ParseWithLengthOpts, but allocates from arena. On failure the arena is rolled back to where it was. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena);
+#endif
+
+#ifdef CJSON_IN_SITU
+/* In-situ parsing: strings and names are unescaped inside value itself and the tree points at them instead of
+ * holding copies, so value must be writable and outlive the tree. arena is optional, pass NULL to allocate the
+ * nodes through the hooks (then free them with cJSON_Delete as usual).
+ * Unescaping starts before the parse is known to succeed: when it fails (returns NULL) value has still been
+ * modified, the strings before the error are unescaped and NUL terminated, so parse a copy if value is needed again. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena);
+#endif
+
+#ifdef CJSON_POOL
+/* Build option: with CJSON_POOL defined the default hooks serve nodes and short strings from statically sized
+ * pools with O(1) free lists instead of malloc, so the JSON heap usage is bounded and can't fragment. Requests
+ * that don't fit a pool slot (print buffers, long strings) are still passed on to malloc. When a pool is
+ * exhausted the allocation fails. Like the hooks, the pools are not thread safe. */
+#ifndef CJSON_POOL_NODES
+#define CJSON_POOL_NODES 32
+#endif
+#ifndef CJSON_POOL_STRINGS
+#define CJSON_POOL_STRINGS 32
+#endif
+/* size of a string slot, strings (including the terminating NUL) up to this length come from the pool */
+#ifndef CJSON_POOL_STRING_SIZE
+#define CJSON_POOL_STRING_SIZE 32
+#endif
+
+typedef struct cJSON_PoolStats
+{
+    size_t nodes_used;
+    size_t nodes_high_water_mark;
+    size_t strings_used;
+    size_t strings_high_water_mark;
+    /* allocations refused because the pool was exhausted */
+    size_t failures;
+    /* allocations too large for the pool that went to malloc */
+    size_t heap_allocations;
+} cJSON_PoolStats;
+
+/* Read the pool counters, use the high water marks to size the pools from field data. */
+CJSON_PUBLIC(void) cJSON_GetPoolStats(cJSON_PoolStats *stats);
+#endif
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -0,0 +1,160 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON_Push__h
+#define cJSON_Push__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Resumable push tokenizer for a stream of flat JSON objects.
+ *
+ * Bytes are fed one at a time or in blocks (the firmware feeds the blocks the receive DMA reports from
+ * its UART task) and every byte takes a bounded amount of work. Each member of the top level object is reported through the callback as
+ * soon as its value is complete, and the closing brace of the object is reported as its own event,
+ * so a message is fully decoded when its last byte arrives. Nested objects/arrays are framed
+ * correctly (braces inside strings included) but only reported as a whole, without their content.
+ * Bytes outside of an object are ignored until the next '{', which also resynchronises after an error. */
+
+/* Maximum length of a member name / a scalar value that is kept. Longer ones are still read to their end,
+ * the member is reported with the first characters and a bit set in 'truncated'. */
+#ifndef CJSON_PUSH_KEY_LENGTH
+#define CJSON_PUSH_KEY_LENGTH 16
+#endif
+#ifndef CJSON_PUSH_VALUE_LENGTH
+#define CJSON_PUSH_VALUE_LENGTH 32
+#endif
+
+/* Limits how deeply nested values of a member can be. */
+#ifndef CJSON_PUSH_NESTING_LIMIT
+#define CJSON_PUSH_NESTING_LIMIT 8
+#endif
+
+/* bits of cJSON_PushParser.truncated */
+#define cJSON_PushKeyTruncated   (1 << 0)
+#define cJSON_PushValueTruncated (1 << 1)
+
+typedef enum cJSON_PushEvent
+{
+    /* a member is complete: key holds its name, type/value its value (NUL terminated), truncated tells
+     * whether either of them was cut to its maximum length */
+    cJSON_PushMember,
+    /* the top level object was closed */
+    cJSON_PushObjectEnd,
+    /* the input is not valid JSON, the current object is dropped */
+    cJSON_PushError
+} cJSON_PushEvent;
+
+struct cJSON_PushParser;
+typedef void (*cJSON_PushCallback)(const struct cJSON_PushParser *parser, cJSON_PushEvent event, void *user_data);
+
+typedef struct cJSON_PushParser
+{
+    cJSON_PushCallback callback;
+    void *user_data;
+    /* in the callback: index of the byte that raised the event in the bytes passed to cJSON_PushBytes */
+    size_t offset;
+
+    /* tokenizer state, private */
+    unsigned char state;
+    unsigned char string_state;
+    unsigned char depth;
+    unsigned char literal_position;
+    unsigned short codepoint;
+    unsigned short high_surrogate;
+    unsigned long nesting; /* one bit per nesting level of a skipped value, set for objects */
+
+    /* current member */
+    int type; /* one of the cJSON types */
+    unsigned char key_length;
+    unsigned char value_length;
+    unsigned char truncated;
+    char key[CJSON_PUSH_KEY_LENGTH + 1];
+    char value[CJSON_PUSH_VALUE_LENGTH + 1];
+} cJSON_PushParser;
+
+CJSON_PUBLIC(void) cJSON_PushInit(cJSON_PushParser *parser, cJSON_PushCallback callback, void *user_data);
+/* Drop any partially received object and wait for the next '{'. */
+CJSON_PUBLIC(void) cJSON_PushReset(cJSON_PushParser *parser);
+/* Feed one byte. Returns false if the byte caused an error (the error event has already been raised). */
+CJSON_PUBLIC(cJSON_bool) cJSON_PushByte(cJSON_PushParser *parser, unsigned char byte);
+/* Feed a block of bytes, same as feeding them one by one but the plain parts of strings are copied at once.
+ * Returns false if any of the bytes caused an error. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PushBytes(cJSON_PushParser *parser, const unsigned char *bytes, size_t length);
+
+/* Schema driven decoding of members straight into a C struct.
+ *
+ * A record describes the expected members with a constant table of fields. Each member reported by the
+ * tokenizer is matched against the table and its value is stored at the field's offset in the target,
+ * so a message is decoded in a single pass without building a tree or allocating anything.
+ * Supported field types:
+ *   cJSON_String: a NUL terminated char array of 'size' bytes, longer strings are errors
+ *   cJSON_Number: an int, only integers are accepted
+ * A null value is accepted for every field and clears it. Members that are not in the table are ignored,
+ * whatever the length of their name or value. A truncated value of a field is an error, and so is a
+ * truncated name that could be the name of a field. */
+
+/* Limits how many fields a record can have (one bit per field in the present/errors masks). */
+#define CJSON_PUSH_FIELD_LIMIT 32
+
+typedef struct cJSON_PushField
+{
+    const char *name;
+    int type;      /* cJSON_String or cJSON_Number */
+    size_t offset; /* of the destination inside the target */
+    size_t size;   /* of the destination */
+} cJSON_PushField;
+
+/* Describe the member 'member' of 'struct_type' as the field 'name' of type 'type'. */
+#define cJSON_PushFieldOf(name, type, struct_type, member) \
+    { (name), (type), offsetof(struct_type, member), sizeof(((struct_type *)0)->member) }
+
+typedef struct cJSON_PushRecord
+{
+    const cJSON_PushField *fields;
+    size_t field_count;
+    void *target;
+
+    /* bit n is set once fields[n] was decoded */
+    unsigned long present;
+    /* bit n is set when fields[n] had the wrong type or didn't fit */
+    unsigned long errors;
+} cJSON_PushRecord;
+
+CJSON_PUBLIC(void) cJSON_PushRecordInit(cJSON_PushRecord *record, const cJSON_PushField *fields, size_t field_count, void *target);
+/* Start the next message: clears the present/errors masks, the target itself is left alone. */
+CJSON_PUBLIC(void) cJSON_PushRecordReset(cJSON_PushRecord *record);
+/* Store the member the tokenizer just reported (call it for cJSON_PushMember events).
+ * Returns false if the member belongs to a field but couldn't be stored. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PushRecordMember(cJSON_PushRecord *record, const cJSON_PushParser *parser);
+/* Check that every field in 'required' (a mask of field bits) is present and no field had an error. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PushRecordComplete(const cJSON_PushRecord *record, unsigned long required);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON_Writer__h
+#define cJSON_Writer__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Streaming writer for JSON objects.
+ *
+ * The text is produced piece by piece and handed to a sink as it is generated, without building a tree,
+ * an intermediate string or using printf. Strings are escaped on the fly. The output is unformatted:
+ *   cJSON_WriterBeginObject(&writer);
+ *   cJSON_WriterKey(&writer, "nodeID");
+ *   cJSON_WriterInt(&writer, 128);
+ *   cJSON_WriterEndObject(&writer);
+ * writes {"nodeID":128} */
+
+/* Limits how deeply objects can be nested. */
+#ifndef CJSON_WRITER_NESTING_LIMIT
+#define CJSON_WRITER_NESTING_LIMIT 8
+#endif
+
+/* Receives the output, a message is usually written in several pieces. */
+typedef void (*cJSON_WriterSink)(const unsigned char *data, size_t length, void *user_data);
+
+typedef struct cJSON_Writer
+{
+    cJSON_WriterSink sink;
+    void *user_data;
+
+    /* private */
+    unsigned char depth;
+    unsigned long has_members; /* one bit per nesting level, set once the object has a member */
+} cJSON_Writer;
+
+CJSON_PUBLIC(void) cJSON_WriterInit(cJSON_Writer *writer, cJSON_WriterSink sink, void *user_data);
+
+/* Start an object, either as the top level value or as the value of a member. Returns false if nested too deeply. */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginObject(cJSON_Writer *writer);
+/* Returns false if there is no object to end. */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndObject(cJSON_Writer *writer);
+/* Start a member, its value has to be written next. */
+CJSON_PUBLIC(void) cJSON_WriterKey(cJSON_Writer *writer, const char *name);
+
+CJSON_PUBLIC(void) cJSON_WriterInt(cJSON_Writer *writer, int number);
+CJSON_PUBLIC(void) cJSON_WriterString(cJSON_Writer *writer, const char *string);
+
+/* Write a string value in several parts, e.g. a number followed by a unit. */
+CJSON_PUBLIC(void) cJSON_WriterStringBegin(cJSON_Writer *writer);
+CJSON_PUBLIC(void) cJSON_WriterStringAppend(cJSON_Writer *writer, const char *string);
+CJSON_PUBLIC(void) cJSON_WriterStringAppendInt(cJSON_Writer *writer, int number);
+CJSON_PUBLIC(void) cJSON_WriterStringEnd(cJSON_Writer *writer);
+
+/* Sink that collects the output in a buffer, pass a cJSON_WriterBuffer as user_data.
+ * The output is always NUL terminated, overflow is set if it had to be cut. */
+typedef struct cJSON_WriterBuffer
+{
+    unsigned char *buffer;
+    size_t size;
+    size_t length;
+    cJSON_bool overflow;
+} cJSON_WriterBuffer;
+
+CJSON_PUBLIC(void) cJSON_WriterBufferInit(cJSON_WriterBuffer *buffer, void *memory, size_t size);
+CJSON_PUBLIC(void) cJSON_WriterBufferSink(const unsigned char *data, size_t length, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * DMA_DRIVER.c
+ *
+ *  Created on: Jan 12, 2025
+ *      Author: Eng.TERA
+ */
+
+
+
+
+//-----------------------------------------
+//-------<< INCLUDES >>--------------------
+//-----------------------------------------
+#include "DMA_DRIVER.h"
+
+
+//-----------------------------------------
+//-------<< Generic Variables >>------------
+//-----------------------------------------
+
+static void (* Global_DMA_CallBack_FN[7])(uint8_t Channel,uint8_t Flags);
+
+//-----------------------------------------
+//-------<< Generic Macros >>------------
+//-----------------------------------------
+#define DMA_Channel_Regs(_channel_)						(&DMA1->DMA_Channel[(_channel_) - 1])
+#define DMA_Flags_Shift(_channel_)						(4 * ((_channel_) - 1))		// GIF, TCIF, HTIF, TEIF of each channel in ISR/IFCR
+
+/**================================================================
+ * @Fn	 		-MCAL_DMA_Init
+ * @brief 		-This Function used to configure a DMA1 channel for byte transfers between a peripheral and memory
+ * @param [in] 	-Channel: 1 to 7, see @ref DMA1 channels of the USART requests
+ * @param [in]	-DMA_Config_s: Is a pointer to the structure that contains the configuration of the channel
+ * @retval		-none
+ * Note			-The channel is left disabled, MCAL_DMA_Start gives it a buffer and starts it
+ */
+void    MCAL_DMA_Init(uint8_t Channel,DMA_Config_t * DMA_Config_s){
+
+	if(Channel < 1 || Channel > 7)
+	{
+		return;
+	}
+
+	DMA_Channel_REGISTERS_t * DMAx = DMA_Channel_Regs(Channel);
+
+	DMA1_CLOCK_EN();
+
+	// 1- Disable the channel and clear its old flags
+	DMAx->DMA_CCR = 0;
+	DMA1->DMA_IFCR = (0xF << DMA_Flags_Shift(Channel));
+
+	// 2- Peripheral data register, 8 bit on both sides (PSIZE = MSIZE = 0)
+	DMAx->DMA_CPAR = DMA_Config_s->Peripheral_Address;
+
+	// 3- Direction, priority, increment and circular mode, interrupts
+	DMAx->DMA_CCR = DMA_Config_s->Direction | DMA_Config_s->Priority | (DMA_Config_s->Interrupts & (DMA_IT_TC | DMA_IT_HT | DMA_IT_TE));
+	if(DMA_Config_s->Memory_Increment_EN == DMA_Enable)
+	{
+		DMAx->DMA_CCR |= (1<<7);
+	}
+	if(DMA_Config_s->Circular_EN == DMA_Enable)
+	{
+		DMAx->DMA_CCR |= (1<<5);
+	}
+
+	Global_DMA_CallBack_FN[Channel - 1] = DMA_Config_s->CallBack_FN;
+
+	if(DMA_Config_s->Interrupts)
+	{
+		NVIC->NVIC_ISER0 = (1<<(DMA1_Channel1_IRQ + Channel - 1));
+	}
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_DMA_Start
+ * @brief 		-This Function (re)starts a configured channel on a new buffer
+ * @param [in] 	-Channel: 1 to 7
+ * @param [in]	-Memory_Address: Address of the first byte in memory
+ * @param [in]	-Count: Number of bytes to transfer (the size of the buffer in circular mode)
+ * @retval		-none
+ * Note			-Can be called from the transfer complete callback to chain transfers
+ */
+void    MCAL_DMA_Start(uint8_t Channel,uint32_t Memory_Address,uint16_t Count){
+
+	if(Channel < 1 || Channel > 7)
+	{
+		return;
+	}
+
+	DMA_Channel_REGISTERS_t * DMAx = DMA_Channel_Regs(Channel);
+
+	// CMAR and CNDTR can only be written while the channel is disabled
+	DMAx->DMA_CCR &= ~(1<<0);
+	DMA1->DMA_IFCR = (0xF << DMA_Flags_Shift(Channel));
+	DMAx->DMA_CMAR = Memory_Address;
+	DMAx->DMA_CNDTR = Count;
+	DMAx->DMA_CCR |= (1<<0);
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_DMA_Stop
+ * @brief 		-This Function disables a channel, a transfer in progress is aborted
+ * @param [in] 	-Channel: 1 to 7
+ * @retval		-none
+ */
+void    MCAL_DMA_Stop(uint8_t Channel){
+
+	if(Channel < 1 || Channel > 7)
+	{
+		return;
+	}
+
+	DMA_Channel_Regs(Channel)->DMA_CCR &= ~(1<<0);
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_DMA_Get_Counter
+ * @brief 		-This Function returns the number of bytes the channel still has to transfer
+ * @param [in] 	-Channel: 1 to 7
+ * @retval		-CNDTR, in circular mode it counts down from the buffer size and reloads after the last byte
+ */
+uint16_t MCAL_DMA_Get_Counter(uint8_t Channel){
+
+	if(Channel < 1 || Channel > 7)
+	{
+		return 0;
+	}
+
+	return (uint16_t)DMA_Channel_Regs(Channel)->DMA_CNDTR;
+}
+
+/*
+ * This function is used by the ISRs to clear the flags of a channel and pass them to its callback
+ * */
+static void DMA_IRQ_Service(uint8_t Channel){
+
+	uint8_t Flags = (DMA1->DMA_ISR >> DMA_Flags_Shift(Channel)) & (DMA_IT_TC | DMA_IT_HT | DMA_IT_TE);
+
+	DMA1->DMA_IFCR = (0xF << DMA_Flags_Shift(Channel));
+	if(Global_DMA_CallBack_FN[Channel - 1] != NULL)
+	{
+		Global_DMA_CallBack_FN[Channel - 1](Channel, Flags);
+	}
+}
+
+//-----------------------------------------------
+//------------------<< ISR >>--------------------
+//-----------------------------------------------
+void DMA1_Channel1_IRQHandler(void)
+{
+	DMA_IRQ_Service(1);
+}
+
+void DMA1_Channel2_IRQHandler(void)
+{
+	DMA_IRQ_Service(2);
+}
+
+void DMA1_Channel3_IRQHandler(void)
+{
+	DMA_IRQ_Service(3);
+}
+
+void DMA1_Channel4_IRQHandler(void)
+{
+	DMA_IRQ_Service(4);
+}
+
+void DMA1_Channel5_IRQHandler(void)
+{
+	DMA_IRQ_Service(5);
+}
+
+void DMA1_Channel6_IRQHandler(void)
+{
+	DMA_IRQ_Service(6);
+}
+
+void DMA1_Channel7_IRQHandler(void)
+{
+	DMA_IRQ_Service(7);
+}
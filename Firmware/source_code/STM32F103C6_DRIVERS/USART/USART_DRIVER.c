@@ -18,20 +18,119 @@
 //-------<< Generic Variables >>------------
 //-----------------------------------------
 
-uint8_t TX_flag1 =0;
-uint8_t RX_flag2 =0;
-uint8_t TC_flag3 =0;
-USART_Config_t Global_USART_Config_s[3];
+// TX ring of each instance: Head is only written by MCAL_USART_Write, Tail only by the ISR.
+// Both are free running, the number of queued bytes is (Head - Tail).
+typedef struct{
+
+	volatile uint16_t Head;
+	volatile uint16_t Tail;
+	uint8_t  Data[USART_TX_BUFFER_SIZE];
+	void (* volatile TX_Complete_FN)(void);
+
+}USART_TX_Ring_t;
+
+// Circular DMA reception of each instance: Last is the offset up to which bytes were already reported.
+// Received and Released are free running byte counts, RTS flow control follows (Received - Released).
+typedef struct{
+
+	uint16_t Size;
+	uint16_t Last;
+	volatile uint32_t Received;
+	volatile uint32_t Released;
+	void (* RX_Frame_FN)(uint16_t Offset,uint16_t Length);
+
+}USART_RX_DMA_t;
+
+// Scatter-gather DMA transmission of each instance: Next is the segment the channel is armed with after the current one
+typedef struct{
+
+	const USART_Segment_t * Segments;
+	uint8_t Count;
+	uint8_t Next;
+	volatile uint8_t Busy;
+
+}USART_TX_DMA_t;
+
+// Auto baud detection of each instance: cycle counter value of every edge of the '{' seen so far on the RX pin
+typedef struct{
+
+	uint32_t Edge_Times[USART_AUTO_BAUD_EDGES];
+	uint8_t Edge_Count;
+	void (* Auto_Baud_FN)(uint32_t Baud_Rate);
+
+}USART_Auto_Baud_t;
+
+// Everything the driver knows about one instance: the fixed wiring first, then the state set up by the APIs.
+// The APIs resolve it from USARTx once (USART_Get_Handle), the ISRs and DMA callbacks use it directly.
+typedef struct{
+
+	USART_REGISTERS_t * Instance;
+	uint8_t Index;						// 0 for USART1, see USART_IRQ_Bit
+	uint8_t RX_DMA_Channel;
+	uint8_t TX_DMA_Channel;
+	GPIO_REGISTERS_t * Port;			// All pins of an instance are on the same port
+	uint8_t TX_Pin;
+	uint8_t RX_Pin;
+	uint8_t RTS_Pin;
+	uint8_t CTS_Pin;
+	uint8_t RX_EXTI_IRQ;				// EXTI line interrupt of the RX pin (as in @ref EXTI_GPIO), for auto baud
+	void (* RX_Edge_FN)(void);
+	uint32_t (* Get_PCLK)(void);		// Bus clock of the instance
+
+	USART_Config_t Config;
+	interrupts_Bits Interrupts;			// USART interrupts enabled by MCAL_USART_Init (SendChar / ReceiveChar don't poll then)
+	USART_TX_Ring_t TX_Ring;
+	USART_RX_DMA_t RX_DMA;
+	USART_TX_DMA_t TX_DMA;
+	USART_Auto_Baud_t Auto_Baud;
+	volatile USART_Stats_t Stats;
+
+}USART_Handle_t;
+
+static void USART1_Auto_Baud_Edge(void);
+static void USART2_Auto_Baud_Edge(void);
+static void USART3_Auto_Baud_Edge(void);
+
+// USART1 TX PA9 RX PA10 RTS PA12 CTS PA11, USART2 TX PA2 RX PA3 RTS PA1 CTS PA0, USART3 TX PB10 RX PB11 RTS PB14 CTS PB13
+static USART_Handle_t Global_USART_Handle_s[3] = {
+	{ USART1 , 0 , DMA_USART1_RX_Channel , DMA_USART1_TX_Channel , GPIOA , 9 , 10 , 12 , 11 , 40 , USART1_Auto_Baud_Edge , RCC_Get_PCLK2 },
+	{ USART2 , 1 , DMA_USART2_RX_Channel , DMA_USART2_TX_Channel , GPIOA , 2 , 3 , 1 , 0 , 9 , USART2_Auto_Baud_Edge , RCC_Get_PCLK1 },
+	{ USART3 , 2 , DMA_USART3_RX_Channel , DMA_USART3_TX_Channel , GPIOB , 10 , 11 , 14 , 13 , 40 , USART3_Auto_Baud_Edge , RCC_Get_PCLK1 },
+};
+
+// Handle of each instance by bits 10..12 of its address: USART1 0x40013800 -> 6, USART2 0x40004400 -> 1, USART3 0x40004800 -> 2
+static USART_Handle_t * const Global_USART_Handle_Lookup[8] = { NULL , &Global_USART_Handle_s[1] , &Global_USART_Handle_s[2] , NULL , NULL , NULL , &Global_USART_Handle_s[0] , NULL };
+
+// Handle using each DMA1 channel (1 to 7), set when the channel is configured
+static USART_Handle_t * Global_USART_DMA_Handle[7];
+
+static const uint32_t Global_USART_Standard_Baud_Rates[] = { 1200 , 2400 , 4800 , 9600 , 19200 , 38400 , 57600 , 115200 , 230400 , 460800 , 921600 };
 
 //-----------------------------------------
 //-------<< Generic Macros >>------------
 //-----------------------------------------
-#define USARTDIV(_clock_,_baudrate_)      				(_clock_/(16*_baudrate_))
-#define USARTDIV_MUL100(_clock_,_baudrate_)				((_clock_*25)/(_baudrate_*4))
-#define Mantissa(_clock_,_baudrate_)					USARTDIV(_clock_,_baudrate_)
-#define Mantissa_MUL100(_clock_,_baudrate_)				(USARTDIV(_clock_,_baudrate_)*100)
-#define DIV_Fraction(_clock_,_baudrate_)				(( ( USARTDIV_MUL100(_clock_,_baudrate_) - Mantissa_MUL100(_clock_,_baudrate_) ) * 16 )/100 )
-#define USART_BRR_Register(_clock_,_baudrate_)			(( Mantissa(_clock_,_baudrate_) << 4 ) | ( DIV_Fraction(_clock_,_baudrate_) & 0x0F ))
+#define USART_IRQ_Bit(_index_)							(1<<(5 + (_index_)))		// USART1..3 are IRQ 37..39, bits 5..7 of ISER1/ICER1
+#define USART_DMA_IRQ_Bit(_channel_)					(1<<(DMA1_Channel1_IRQ + (_channel_) - 1))	// DMA1 channels are IRQ 11..17, in ISER0/ICER0
+#define USART_RX_Errors									0xF			// PE, FE, NE and ORE in SR
+#define USART_Compiler_Barrier()						__asm volatile ("" ::: "memory")
+
+#if (USART_TX_BUFFER_SIZE & (USART_TX_BUFFER_SIZE - 1)) || (USART_TX_BUFFER_SIZE > 32768)
+#error USART_TX_BUFFER_SIZE must be a power of two up to 32768
+#endif
+
+/*
+ * This function is used by uart driver to get the handle of the used instance, NULL for a wrong address of USARTx
+ * */
+static USART_Handle_t * USART_Get_Handle(USART_REGISTERS_t * USARTx){
+
+	USART_Handle_t * Handle = Global_USART_Handle_Lookup[ ((uint32_t)USARTx >> 10) & 0x7 ];
+
+	if(Handle == NULL || Handle->Instance != USARTx)
+	{
+		return NULL;
+	}
+	return Handle;
+}
 
 /**================================================================
  * @Fn	 		-MCAL_USART_Init
@@ -43,19 +142,17 @@ USART_Config_t Global_USART_Config_s[3];
  */
 void    MCAL_USART_Init(USART_REGISTERS_t * USARTx,USART_Config_t * USART_Config_s){
 
-	Global_USART_Config_s[0] = *USART_Config_s;
-	if(USARTx == USART1)
-	{
-		Global_USART_Config_s[0] = *USART_Config_s;
-	}
-	else if(USARTx == USART2)
-	{
-		Global_USART_Config_s[1] = *USART_Config_s;
-	}
-	else if(USARTx == USART3)
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
 	{
-		Global_USART_Config_s[2] = *USART_Config_s;
+		return;
 	}
+
+	Handle->Config = *USART_Config_s;
+	Handle->Interrupts.TX_Interrupt = 0;
+	Handle->Interrupts.RX_Interrupt = 0;
+	Handle->Interrupts.TC_Interrupt = 0;
+
 	if(USART_Config_s->Sync_EN == USART_Enable)
 	{
 		// 1- Bit 11 CLKEN: Clock enable
@@ -81,9 +178,9 @@ void    MCAL_USART_Init(USART_REGISTERS_t * USARTx,USART_Config_t * USART_Config
 
 		USARTx->USART_CR2 |= USART_Config_s->Async_Config_s.Stop_Bits;
 
-		// 5 - Select the desired baud rate using the USART_BRR register.
+		// 5 - Select the desired baud rate using the USART_BRR register (left alone if the rate is rejected).
 
-		USARTx->USART_BRR |= USART_BRR_Register(RCC_Get_PCLK2(),USART_Config_s->Async_Config_s.Baud_Rate);
+		MCAL_USART_Set_Baud_Rate(USARTx, USART_Config_s->Async_Config_s.Baud_Rate);
 
 		// 6 - Set Parity Configurations
 
@@ -93,60 +190,266 @@ void    MCAL_USART_Init(USART_REGISTERS_t * USARTx,USART_Config_t * USART_Config
 			USARTx->USART_CR1 |= (1<<10);
 			USARTx->USART_CR1 |= USART_Config_s->Async_Config_s.Parity.Parity_Even_Odd;
 		}
+
+		// 7 - CTS is handled by the USART (CTSE). RTS is driven by the driver from the RX DMA buffer, since
+		//     with DMA reception DR never stays full and the hardware RTS (RTSE) would never be deasserted
+
+		if(USART_Config_s->Flow_Control & USART_Flow_CTS)
+		{
+			USARTx->USART_CR3 |= (1<<9);
+		}
 	}
 
 	if( (USART_Config_s->interrupts_CNFG.TX_Interrupt_Enable_Or_Disable) == USART_Enable )
 	{
 		USARTx->USART_CR1 |= (1<<7);
-		TX_flag1 =1;
+		Handle->Interrupts.TX_Interrupt = 1;
 	}
 	if( (USART_Config_s->interrupts_CNFG.RX_Interrupt_Enable_Or_Disable) == USART_Enable )
 	{
 		USARTx->USART_CR1 |= (1<<5);
-		RX_flag2=1;
+		Handle->Interrupts.RX_Interrupt = 1;
 	}
 	if( (USART_Config_s->interrupts_CNFG.TC_Interrupt_Enable_Or_Disable) == USART_Enable )
 	{
 		USARTx->USART_CR1 |= (1<<6);
-		TC_flag3=1;
+		Handle->Interrupts.TC_Interrupt = 1;
 	}
 
-	if( (TX_flag1 || RX_flag2 || TC_flag3) )
+	if( Handle->Interrupts.TX_Interrupt || Handle->Interrupts.RX_Interrupt || Handle->Interrupts.TC_Interrupt )
 	{
+		NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+	}
+}
 
-		if(USARTx == USART1)
-		{
-			NVIC->NVIC_ISER1 |= (1<< 5 );
-		}
-		else if(USARTx == USART2)
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Calculate_BRR
+ * @brief 		-This Function computes the BRR value whose baud rate is closest to the wanted one
+ * @param [in] 	-PCLK: Clock of the USART in Hz
+ * @param [in]	-Baud_Rate: Wanted baud rate
+ * @param [out]	-Error_PPM: Deviation of the resulting baud rate in parts per million (can be NULL)
+ * @retval		-BRR value, 0 if the rate is out of range for this clock
+ * Note			-BRR is USARTDIV (PCLK / (16 * Baud_Rate)) with 4 fraction bits, i.e. PCLK / Baud_Rate.
+ * 				 Rounding the whole value carries a rounded up fraction into the mantissa
+ */
+uint16_t MCAL_USART_Calculate_BRR(uint32_t PCLK,uint32_t Baud_Rate,uint32_t * Error_PPM){
+
+	uint32_t BRR;
+	uint32_t Actual;
+
+	if(Baud_Rate == 0)
+	{
+		return 0;
+	}
+
+	// Round up when PCLK / (BRR + 1) is nearer to the rate than PCLK / BRR
+	BRR = PCLK / Baud_Rate;
+	if( (uint64_t)(PCLK - BRR * Baud_Rate) * (BRR + 1) > (uint64_t)((BRR + 1) * Baud_Rate - PCLK) * BRR )
+	{
+		BRR++;
+	}
+
+	// The mantissa must be 1 to 4095
+	if(BRR < 16 || BRR > 0xFFFF)
+	{
+		return 0;
+	}
+
+	if(Error_PPM != NULL)
+	{
+		Actual = BRR * Baud_Rate;		// PCLK for an exact rate
+		*Error_PPM = (uint32_t)( ( (uint64_t)(Actual > PCLK ? Actual - PCLK : PCLK - Actual) * 1000000 ) / Actual );
+	}
+
+	return (uint16_t)BRR;
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Set_Baud_Rate
+ * @brief 		-This Function programs the baud rate of an USART from its current bus clock
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Baud_Rate: Wanted baud rate
+ * @retval		-1 if BRR was written, 0 if the rate can't be reached within USART_BAUD_MAX_ERROR_PPM (BRR unchanged)
+ * Note			-USART1 runs from PCLK2, USART2 and USART3 from PCLK1. Call it while nothing is being sent or
+ * 				 received, a frame on the line during the change is corrupted
+ */
+uint8_t MCAL_USART_Set_Baud_Rate(USART_REGISTERS_t * USARTx,uint32_t Baud_Rate){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	uint32_t Error_PPM;
+	uint16_t BRR;
+
+	if(Handle == NULL)
+	{
+		return 0;
+	}
+
+	BRR = MCAL_USART_Calculate_BRR(Handle->Get_PCLK(), Baud_Rate, &Error_PPM);
+	if(BRR == 0 || Error_PPM > USART_BAUD_MAX_ERROR_PPM)
+	{
+		return 0;
+	}
+
+	USARTx->USART_BRR = BRR;
+	Handle->Config.Async_Config_s.Baud_Rate = Baud_Rate;
+
+	return 1;
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Auto_Baud_BRR
+ * @brief 		-This Function computes BRR from the edge times of a received '{'
+ * @param [in] 	-Edge_Times: USART_AUTO_BAUD_EDGES timestamps in HCLK cycles, starting with the falling edge of the start bit
+ * @param [in]	-HCLK: Clock of the timestamps in Hz
+ * @param [in]	-PCLK: Clock of the USART in Hz
+ * @param [out]	-Baud_Rate: The detected baud rate (can be NULL)
+ * @retval		-BRR value, 0 if the edges are not those of a '{' or the rate is not within 3% of a standard one
+ * Note			-0x7B is sent LSB first: start bit low, 2 bits high, 1 low, 4 high, 1 low then the stop bit,
+ * 				 so the edges are at 0, 1, 3, 4, 8 and 9 bit times
+ */
+uint16_t MCAL_USART_Auto_Baud_BRR(const uint32_t * Edge_Times,uint32_t HCLK,uint32_t PCLK,uint32_t * Baud_Rate){
+
+	static const uint8_t Bit_Positions[USART_AUTO_BAUD_EDGES] = { 0 , 1 , 3 , 4 , 8 , 9 };
+	uint32_t Total = Edge_Times[USART_AUTO_BAUD_EDGES - 1] - Edge_Times[0];		// 9 bit times
+	uint32_t Baud;
+	uint32_t Error_PPM;
+	uint16_t BRR;
+	uint8_t i;
+
+	if(Total == 0 || HCLK == 0 || PCLK == 0)
+	{
+		return 0;
+	}
+
+	// Every edge must be within a quarter bit of its place: |9 * t - position * Total| <= Total / 4
+	for(i = 1; i < USART_AUTO_BAUD_EDGES - 1; i++)
+	{
+		uint32_t Place = Bit_Positions[i] * Total;
+		uint32_t Time = 9 * (Edge_Times[i] - Edge_Times[0]);
+
+		if( (Time > Place ? Time - Place : Place - Time) > Total / 4 )
 		{
-			NVIC->NVIC_ISER1 |= (1<<6);
+			return 0;
 		}
-		else if(USARTx == USART3)
+	}
+
+	// 9 bit times took Total HCLK cycles
+	Baud = (uint32_t)( ( (uint64_t)HCLK * 9 + Total / 2 ) / Total );
+
+	// The measurement is only as good as the interrupt latency, only a close standard rate is taken
+	for(i = 0; i < sizeof(Global_USART_Standard_Baud_Rates) / sizeof(Global_USART_Standard_Baud_Rates[0]); i++)
+	{
+		uint32_t Standard = Global_USART_Standard_Baud_Rates[i];
+
+		if( (uint64_t)(Baud > Standard ? Baud - Standard : Standard - Baud) * 1000000 <= (uint64_t)Standard * USART_AUTO_BAUD_SNAP_PPM )
 		{
-			NVIC->NVIC_ISER1 |= (1<<7);
+			break;
 		}
 	}
-}
+	if(i == sizeof(Global_USART_Standard_Baud_Rates) / sizeof(Global_USART_Standard_Baud_Rates[0]))
+	{
+		return 0;
+	}
+	Baud = Global_USART_Standard_Baud_Rates[i];
 
+	BRR = MCAL_USART_Calculate_BRR(PCLK, Baud, &Error_PPM);
+	if(BRR == 0 || Error_PPM > USART_BAUD_MAX_ERROR_PPM)
+	{
+		return 0;
+	}
+
+	if(Baud_Rate != NULL)
+	{
+		*Baud_Rate = Baud;
+	}
+	return BRR;
+}
 
 /*
- * This functions is used by uart driver to get the index of the global array for the used instance
+ * This function is used by the EXTI callbacks to timestamp an edge on the RX pin and, after the last edge of the '{',
+ * to program BRR and turn the receiver back on before the next start bit
  * */
-static uint8_t Which_UART(USART_REGISTERS_t * USARTx){
-	if(USARTx == USART1)
+static void USART_Auto_Baud_Edge(USART_Handle_t * Handle){
+
+	USART_Auto_Baud_t * Auto_Baud = &Handle->Auto_Baud;
+	USART_REGISTERS_t * USARTx = Handle->Instance;
+	uint32_t Now = DWT->DWT_CYCCNT;
+	uint32_t Baud_Rate;
+	uint16_t BRR;
+
+	// The first edge must be the falling edge of a start bit
+	if(Auto_Baud->Edge_Count == 0 && MCAL_GPIO_ReadPin(Handle->Port, Handle->RX_Pin))
 	{
-		return 0;
+		return;
+	}
+
+	Auto_Baud->Edge_Times[Auto_Baud->Edge_Count++] = Now;
+	if(Auto_Baud->Edge_Count < USART_AUTO_BAUD_EDGES)
+	{
+		return;
+	}
+
+	// Not a '{' (or an edge was missed): start over with the next falling edge
+	Auto_Baud->Edge_Count = 0;
+	BRR = MCAL_USART_Auto_Baud_BRR(Auto_Baud->Edge_Times, RCC_Get_HCLK(), Handle->Get_PCLK(), &Baud_Rate);
+	if(BRR == 0)
+	{
+		return;
 	}
-	else if(USARTx == USART2)
+
+	EXTI->EXTI_IMR &= ~(1 << Handle->RX_Pin);
+	USARTx->USART_BRR = BRR;
+	USARTx->USART_CR1 |= (1<<2);
+	Handle->Config.Async_Config_s.Baud_Rate = Baud_Rate;
+
+	if(Auto_Baud->Auto_Baud_FN != NULL)
 	{
-		return 1;
+		Auto_Baud->Auto_Baud_FN(Baud_Rate);
 	}
-	else if(USARTx == USART3)
+}
+
+static void USART1_Auto_Baud_Edge(void){ USART_Auto_Baud_Edge(&Global_USART_Handle_s[0]); }
+static void USART2_Auto_Baud_Edge(void){ USART_Auto_Baud_Edge(&Global_USART_Handle_s[1]); }
+static void USART3_Auto_Baud_Edge(void){ USART_Auto_Baud_Edge(&Global_USART_Handle_s[2]); }
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Start_Auto_Baud
+ * @brief 		-This Function turns the receiver off and measures the next '{' on the RX pin (EXTI on both edges,
+ * 				 timestamps from the DWT cycle counter), then programs BRR and turns the receiver back on
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Auto_Baud_FN: Called from the ISR with the detected rate, the '{' itself is not received
+ * @retval		-none
+ * Note			-Every edge is timestamped in an interrupt, so its latency limits the rate: at 8 MHz HCLK this is
+ * 				 reliable up to 38400 baud, 57600 with little other interrupt load. Garbage that is not a '{'
+ * 				 is skipped. The transmitter keeps using the old rate until the '{' is measured
+ */
+void 	MCAL_USART_Start_Auto_Baud(USART_REGISTERS_t * USARTx,void (* Auto_Baud_FN)(uint32_t Baud_Rate)){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
 	{
-		return 3;
+		return;
 	}
-	return 4;		//will cause error for user when he uses wrong address for USARTx
+
+	USART_Auto_Baud_t * Auto_Baud = &Handle->Auto_Baud;
+	EXTI_Config_t EXTI_CNFG_s;
+
+	// 1- Nothing is received until the rate is known
+	USARTx->USART_CR1 &= ~(1<<2);
+
+	Auto_Baud->Edge_Count = 0;
+	Auto_Baud->Auto_Baud_FN = Auto_Baud_FN;
+	DWT_CYCCNT_EN();
+
+	// 2- Both edges of the RX pin (the EXTI driver leaves it an input, as the USART needs it)
+	EXTI_CNFG_s.EXTI_GPIO_Mapping.Port = Handle->Port;
+	EXTI_CNFG_s.EXTI_GPIO_Mapping.Pin_num = Handle->RX_Pin;
+	EXTI_CNFG_s.EXTI_GPIO_Mapping.IRQ_num = Handle->RX_EXTI_IRQ;
+	EXTI_CNFG_s.Function_call = Handle->RX_Edge_FN;
+	EXTI_CNFG_s.Rising_or_Falling = BOTH;
+
+	MCAL_EXTI_init(&EXTI_CNFG_s);
 }
 
 /**================================================================
@@ -159,19 +462,23 @@ static uint8_t Which_UART(USART_REGISTERS_t * USARTx){
  */
 void    MCAL_USART_SendChar(USART_REGISTERS_t * USARTx,char Buffer){
 
-	if(!(  (TX_flag1)||(TC_flag3) ))
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
+	{
+		return;
+	}
+
+	if(!(  (Handle->Interrupts.TX_Interrupt)||(Handle->Interrupts.TC_Interrupt) ))
 	{
 		while(!( USARTx->USART_SR & (1<<7) ) );
 
 	}
 
-	uint8_t Gindex=Which_UART(USARTx);
-
-	if(Global_USART_Config_s[Gindex].Async_Config_s.Word_Length == Nine_bits)
+	if(Handle->Config.Async_Config_s.Word_Length == Nine_bits)
 	{
 		USARTx->USART_DR = ( Buffer  & 0x01FF );
 	}
-	else if(Global_USART_Config_s[Gindex].Async_Config_s.Word_Length == Eight_bits)
+	else if(Handle->Config.Async_Config_s.Word_Length == Eight_bits)
 	{
 		USARTx->USART_DR = ( Buffer  & 0xFF );
 	}
@@ -190,16 +497,21 @@ void    MCAL_USART_SendChar(USART_REGISTERS_t * USARTx,char Buffer){
  */
 void MCAL_USART_ReceiveChar(USART_REGISTERS_t * USARTx,char* Buffer){
 
-	if( !(  (TX_flag1)||(RX_flag2)||(TC_flag3) )  )
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
+	{
+		return;
+	}
+
+	if( !(  (Handle->Interrupts.TX_Interrupt)||(Handle->Interrupts.RX_Interrupt)||(Handle->Interrupts.TC_Interrupt) )  )
 	{
 		while(!( USARTx->USART_SR & (1<<5) ) );
 
 	}
-	uint8_t Gindex=Which_UART(USARTx);
 
-	if(Global_USART_Config_s[Gindex].Async_Config_s.Word_Length == Nine_bits)
+	if(Handle->Config.Async_Config_s.Word_Length == Nine_bits)
 	{
-		if(Global_USART_Config_s[Gindex].Async_Config_s.Parity.Parity_Enable)
+		if(Handle->Config.Async_Config_s.Parity.Parity_Enable)
 		{
 			*Buffer = USARTx->USART_DR   & 0xFF ;
 		}
@@ -208,9 +520,9 @@ void MCAL_USART_ReceiveChar(USART_REGISTERS_t * USARTx,char* Buffer){
 			*Buffer = USARTx->USART_DR & 0x01FF;
 		}
 	}
-	else if(Global_USART_Config_s[Gindex].Async_Config_s.Word_Length == Eight_bits)
+	else if(Handle->Config.Async_Config_s.Word_Length == Eight_bits)
 	{
-		if(Global_USART_Config_s[Gindex].Async_Config_s.Parity.Parity_Enable)
+		if(Handle->Config.Async_Config_s.Parity.Parity_Enable)
 		{
 			*Buffer = USARTx->USART_DR   & 0x7F ;
 		}
@@ -231,54 +543,39 @@ void MCAL_USART_ReceiveChar(USART_REGISTERS_t * USARTx,char* Buffer){
  */
 void 	MCAL_USART_GPIO_Pins_Config(USART_REGISTERS_t * USARTx){
 
-	// USARTx_RX Full duplex Input floating / Input pull-up
-	// USARTx_TX(1) Full duplex Alternate function push-pull
-	if(USARTx == USART1)
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
 	{
-		// USART1_TX PA9
-		//USART1_RX PA10
-		Pin_Config_t GPIO_Pin_CNFG_s;
-		GPIO_Pin_CNFG_s.Pin_Num = 9;
-		GPIO_Pin_CNFG_s.mode = Output_ALF_Push_pull;
-		GPIO_Pin_CNFG_s.Speed_Output = speed_10;
-		MCAL_GPIO_Init(GPIOA, &GPIO_Pin_CNFG_s);
-
-		GPIO_Pin_CNFG_s.Pin_Num = 10;
-		GPIO_Pin_CNFG_s.mode = Input_AF;
-		MCAL_GPIO_Init(GPIOA, &GPIO_Pin_CNFG_s);
-
+		return;
 	}
-	else if(USARTx == USART2)
-	{
-		// USART2_RX PA3
-		//USART2_TX PA2
-		Pin_Config_t GPIO_Pin_CNFG_s;
-		GPIO_Pin_CNFG_s.Pin_Num = 2;
-		GPIO_Pin_CNFG_s.mode = Output_ALF_Push_pull;
-		GPIO_Pin_CNFG_s.Speed_Output = speed_10;
-		MCAL_GPIO_Init(GPIOA, &GPIO_Pin_CNFG_s);
 
-		GPIO_Pin_CNFG_s.Pin_Num = 3;
-		GPIO_Pin_CNFG_s.mode = Input_AF;
-		MCAL_GPIO_Init(GPIOA, &GPIO_Pin_CNFG_s);
+	Pin_Config_t GPIO_Pin_CNFG_s;
 
+	// USARTx_RX Full duplex Input floating / Input pull-up
+	// USARTx_TX(1) Full duplex Alternate function push-pull
+	GPIO_Pin_CNFG_s.Pin_Num = Handle->TX_Pin;
+	GPIO_Pin_CNFG_s.mode = Output_ALF_Push_pull;
+	GPIO_Pin_CNFG_s.Speed_Output = speed_10;
+	MCAL_GPIO_Init(Handle->Port, &GPIO_Pin_CNFG_s);
+
+	GPIO_Pin_CNFG_s.Pin_Num = Handle->RX_Pin;
+	GPIO_Pin_CNFG_s.mode = Input_AF;
+	MCAL_GPIO_Init(Handle->Port, &GPIO_Pin_CNFG_s);
+
+	// USARTx_RTS General purpose push-pull, low (ready to receive) until the RX DMA buffer fills up
+	// USARTx_CTS Input floating
+	if(Handle->Config.Flow_Control & USART_Flow_RTS)
+	{
+		Handle->Port->GPIOx_BRR = (1<<Handle->RTS_Pin);
+		GPIO_Pin_CNFG_s.Pin_Num = Handle->RTS_Pin;
+		GPIO_Pin_CNFG_s.mode = Output_Push_pull;
+		MCAL_GPIO_Init(Handle->Port, &GPIO_Pin_CNFG_s);
 	}
-
-	else if(USARTx == USART3)
+	if(Handle->Config.Flow_Control & USART_Flow_CTS)
 	{
-		//USART3_RX PB11
-		//USART3_TX PB10
-
-		Pin_Config_t GPIO_Pin_CNFG_s;
-		GPIO_Pin_CNFG_s.Pin_Num = 10;
-		GPIO_Pin_CNFG_s.mode = Output_ALF_Push_pull;
-		GPIO_Pin_CNFG_s.Speed_Output = speed_10;
-		MCAL_GPIO_Init(GPIOB, &GPIO_Pin_CNFG_s);
-
-		GPIO_Pin_CNFG_s.Pin_Num = 11;
-		GPIO_Pin_CNFG_s.mode = Input_AF;
-		MCAL_GPIO_Init(GPIOB, &GPIO_Pin_CNFG_s);
-
+		GPIO_Pin_CNFG_s.Pin_Num = Handle->CTS_Pin;
+		GPIO_Pin_CNFG_s.mode = Input_floating;
+		MCAL_GPIO_Init(Handle->Port, &GPIO_Pin_CNFG_s);
 	}
 }
 
@@ -320,19 +617,567 @@ void receiveJSON(USART_REGISTERS_t *USARTx, char *buffer, uint32_t bufferSize) {
     buffer[index] = '\0';
 }
 
+/**================================================================
+ * @Fn	 		-MCAL_USART_Write
+ * @brief 		-This Function queues bytes in the TX ring of the instance and returns without waiting,
+ * 				 the ring is sent from the TXE interrupt
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Buffer: Is a pointer to the bytes that we want to send
+ * @param [in]	-Length: Number of bytes in Buffer
+ * @retval		-Number of bytes queued, less than Length when the ring is full (the caller sends the rest later),
+ * 				 0 while MCAL_USART_WriteDMA is sending
+ * Note			-Only one task may write to an instance at a time, and MCAL_USART_SendChar must not be
+ * 				 mixed with this function on the same instance. 8 bit frames only
+ */
+uint32_t MCAL_USART_Write(USART_REGISTERS_t * USARTx,const uint8_t * Buffer,uint32_t Length){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL || Handle->TX_DMA.Busy)
+	{
+		return 0;
+	}
+
+	USART_TX_Ring_t * Ring = &Handle->TX_Ring;
+	uint16_t Head = Ring->Head;
+	uint32_t Free = USART_TX_BUFFER_SIZE - (uint16_t)(Head - Ring->Tail);
+	uint32_t Count;
+
+	if(Length > Free)
+	{
+		Length = Free;
+	}
+	if(Length == 0)
+	{
+		return 0;
+	}
+
+	for(Count = 0; Count < Length; Count++)
+	{
+		Ring->Data[(uint16_t)(Head + Count) & (USART_TX_BUFFER_SIZE - 1)] = Buffer[Count];
+	}
+
+	// The data must be in the ring before the ISR can see the new Head
+	USART_Compiler_Barrier();
+	Ring->Head = (uint16_t)(Head + Length);
+
+	// The ISR also changes CR1, so its interrupt is masked while TXEIE is set (and a pending TCIE dropped)
+	NVIC_ICER->NVIC_ICER1 = USART_IRQ_Bit(Handle->Index);
+	USARTx->USART_CR1 &= ~(1<<6);
+	USARTx->USART_CR1 |= (1<<7);
+	NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+
+	return Length;
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Set_TX_Complete_Callback
+ * @brief 		-This Function sets the function called once everything queued by MCAL_USART_Write
+ * 				 has left the TX pin (transmission complete)
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-TX_Complete_FN: Called from the ISR, NULL disables the notification
+ * @retval		-none
+ * Note			-Without a callback the TC interrupt is not used at all
+ */
+void 	MCAL_USART_Set_TX_Complete_Callback(USART_REGISTERS_t * USARTx,void (* TX_Complete_FN)(void)){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
+	{
+		return;
+	}
+
+	Handle->TX_Ring.TX_Complete_FN = TX_Complete_FN;
+}
+
+/*
+ * This function is used by the ISRs to send the next byte of the TX ring and raise the completion callback
+ * */
+static void USART_TX_Service(USART_Handle_t * Handle){
+
+	USART_REGISTERS_t * USARTx = Handle->Instance;
+	USART_TX_Ring_t * Ring = &Handle->TX_Ring;
+	uint32_t SR = USARTx->USART_SR;
+	uint32_t CR1 = USARTx->USART_CR1;
+
+	if( (CR1 & (1<<7)) && (SR & (1<<7)) )
+	{
+		uint16_t Tail = Ring->Tail;
+
+		if(Tail != Ring->Head)
+		{
+			USARTx->USART_DR = Ring->Data[Tail & (USART_TX_BUFFER_SIZE - 1)];
+			Ring->Tail = (uint16_t)(Tail + 1);
+		}
+		else
+		{
+			// Ring is empty, wait for the last frame to be shifted out only if someone is waiting for it
+			USARTx->USART_CR1 &= ~(1<<7);
+			if(Ring->TX_Complete_FN != NULL)
+			{
+				USARTx->USART_CR1 |= (1<<6);
+			}
+		}
+	}
+	else if( (CR1 & (1<<6)) && (SR & (1<<6)) )
+	{
+		USARTx->USART_CR1 &= ~(1<<6);
+		if(Ring->TX_Complete_FN != NULL)
+		{
+			Ring->TX_Complete_FN();
+		}
+	}
+}
+
+/*
+ * This function arms the TX DMA channel with the next non empty segment, returns 0 when there is none left
+ * */
+static uint8_t USART_TX_DMA_Next(USART_Handle_t * Handle){
+
+	USART_TX_DMA_t * TX = &Handle->TX_DMA;
+
+	while(TX->Next < TX->Count)
+	{
+		const USART_Segment_t * Segment = &TX->Segments[TX->Next++];
+
+		if(Segment->Length > 0)
+		{
+			MCAL_DMA_Start(Handle->TX_DMA_Channel, (uint32_t)Segment->Data, Segment->Length);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void USART_TX_DMA_Callback(uint8_t Channel,uint8_t Flags){
+
+	USART_Handle_t * Handle = Global_USART_DMA_Handle[Channel - 1];
+
+	if(Handle == NULL || !Handle->TX_DMA.Busy)
+	{
+		return;
+	}
+
+	// Chain the next segment as soon as the current one is in the USART, a transfer error drops the rest
+	if( (Flags & DMA_IT_TE) || !USART_TX_DMA_Next(Handle) )
+	{
+		MCAL_DMA_Stop(Channel);
+		Handle->TX_DMA.Busy = 0;
+
+		// The completion callback follows once the last frame is shifted out (TC interrupt)
+		if(Handle->TX_Ring.TX_Complete_FN != NULL)
+		{
+			Handle->Instance->USART_CR1 |= (1<<6);
+		}
+	}
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_WriteDMA
+ * @brief 		-This Function sends a list of segments back to back with the TX DMA, the channel is re-armed with
+ * 				 the next segment from its transfer complete interrupt so the segments are never copied
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Segments: The pieces of the message (e.g. a constant prefix in flash, formatted digits, a suffix)
+ * @param [in]	-Count: Number of segments
+ * @retval		-1 if the transfer was started, 0 if the USART is still sending (DMA or TX ring) and nothing was done
+ * Note			-The segments and the data they point to must stay valid until MCAL_USART_TX_Busy returns 0.
+ * 				 The completion callback of MCAL_USART_Set_TX_Complete_Callback is raised at the end as well
+ */
+uint8_t MCAL_USART_WriteDMA(USART_REGISTERS_t * USARTx,const USART_Segment_t * Segments,uint8_t Count){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL || Segments == NULL)
+	{
+		return 0;
+	}
+
+	USART_TX_DMA_t * TX = &Handle->TX_DMA;
+	USART_TX_Ring_t * Ring = &Handle->TX_Ring;
+	DMA_Config_t DMA_CNFG_s;
+
+	if(TX->Busy || Ring->Head != Ring->Tail)
+	{
+		return 0;
+	}
+
+	DMA_CNFG_s.Peripheral_Address = (uint32_t)&USARTx->USART_DR;
+	DMA_CNFG_s.Direction = DMA_Memory_To_Peripheral;
+	DMA_CNFG_s.Circular_EN = DMA_Disable;
+	DMA_CNFG_s.Memory_Increment_EN = DMA_Enable;
+	DMA_CNFG_s.Priority = DMA_Priority_Medium;
+	DMA_CNFG_s.Interrupts = DMA_IT_TC | DMA_IT_TE;
+	DMA_CNFG_s.CallBack_FN = USART_TX_DMA_Callback;
+	Global_USART_DMA_Handle[Handle->TX_DMA_Channel - 1] = Handle;
+	MCAL_DMA_Init(Handle->TX_DMA_Channel, &DMA_CNFG_s);
+
+	TX->Segments = Segments;
+	TX->Count = Count;
+	TX->Next = 0;
+	TX->Busy = 1;
+
+	// The ISR also changes CR1: mask it while TXEIE (ring is empty) and a pending TCIE are dropped and DMA requests
+	// on TXE (DMAT) are enabled. TC is cleared here since the DMA writes DR without the SR read that normally clears it
+	NVIC_ICER->NVIC_ICER1 = USART_IRQ_Bit(Handle->Index);
+	USARTx->USART_CR1 &= ~( (1<<6) | (1<<7) );
+	USARTx->USART_SR = ~(1<<6);
+	USARTx->USART_CR3 |= (1<<7);
+	if(!USART_TX_DMA_Next(Handle))
+	{
+		TX->Busy = 0;
+	}
+	NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+
+	return 1;
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_TX_Busy
+ * @brief 		-This Function tells if data given to MCAL_USART_Write or MCAL_USART_WriteDMA is still waiting to be sent
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @retval		-1 while the TX ring or the TX DMA has data left, else 0
+ * Note			-The last frame can still be in the shift register when it returns 0
+ */
+uint8_t MCAL_USART_TX_Busy(USART_REGISTERS_t * USARTx){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
+	{
+		return 0;
+	}
+
+	return ( Handle->TX_DMA.Busy || (Handle->TX_Ring.Head != Handle->TX_Ring.Tail) );
+}
+
+/*
+ * This function reports the bytes received since the last call, given the offset the DMA will write next.
+ * A run that wraps past the end of the buffer is reported as two frames so each one is contiguous.
+ * */
+static void USART_RX_DMA_Report(USART_RX_DMA_t * RX,uint16_t Position){
+
+	if(Position >= RX->Size)
+	{
+		Position = 0;
+	}
+	if(Position == RX->Last || RX->RX_Frame_FN == NULL)
+	{
+		RX->Last = Position;
+		return;
+	}
+
+	// Counted before the callback, which may release the bytes right away
+	if(Position > RX->Last)
+	{
+		RX->Received += Position - RX->Last;
+		RX->RX_Frame_FN(RX->Last, Position - RX->Last);
+	}
+	else
+	{
+		RX->Received += RX->Size - RX->Last;
+		RX->RX_Frame_FN(RX->Last, RX->Size - RX->Last);
+		if(Position > 0)
+		{
+			RX->Received += Position;
+			RX->RX_Frame_FN(0, Position);
+		}
+	}
+	RX->Last = Position;
+}
+
+/*
+ * This function drives RTS from the bytes not released yet: deasserted (high) from the high water mark,
+ * asserted (low) again at the low water mark. BSRR / BRR keep it safe against other users of the port.
+ * */
+static void USART_RX_Flow_Update(USART_Handle_t * Handle){
+
+	USART_RX_DMA_t * RX = &Handle->RX_DMA;
+	uint32_t Pending = RX->Received - RX->Released;
+
+	if( !(Handle->Config.Flow_Control & USART_Flow_RTS) )
+	{
+		return;
+	}
+
+	if(Pending >= Handle->Config.RX_High_Water)
+	{
+		Handle->Port->GPIOx_BSRR = (1<<Handle->RTS_Pin);
+	}
+	else if(Pending <= Handle->Config.RX_Low_Water)
+	{
+		Handle->Port->GPIOx_BRR = (1<<Handle->RTS_Pin);
+	}
+}
+
+/*
+ * This function is used by the USART ISRs (idle line) and the DMA callback (half / full buffer) to report new bytes
+ * */
+static void USART_RX_DMA_Service(USART_Handle_t * Handle){
+
+	USART_RX_DMA_t * RX = &Handle->RX_DMA;
+
+	if(RX->Size == 0)
+	{
+		return;
+	}
+	USART_RX_DMA_Report(RX, RX->Size - MCAL_DMA_Get_Counter(Handle->RX_DMA_Channel));
+	USART_RX_Flow_Update(Handle);
+}
+
+static void USART_RX_DMA_Callback(uint8_t Channel,uint8_t Flags){
+
+	USART_Handle_t * Handle = Global_USART_DMA_Handle[Channel - 1];
+
+	if(Handle != NULL)
+	{
+		USART_RX_DMA_Service(Handle);
+	}
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Start_RX_DMA
+ * @brief 		-This Function makes the DMA write every received byte into a circular buffer, the received bytes are
+ * 				 reported as (offset, length) frames when the line goes idle and when half / all of the buffer is filled
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Buffer: The circular buffer, it belongs to the DMA until the USART is reinitialized
+ * @param [in]	-Size: Size of Buffer in bytes
+ * @param [in]	-RX_Frame_FN: Called from the ISR with the position of new bytes in Buffer, they have to be
+ * 				 consumed before the DMA comes around again (Size bytes later)
+ * @retval		-none
+ * Note			-Call it after MCAL_USART_Init, the RX interrupt and MCAL_USART_ReceiveChar are not used anymore.
+ * 				 The USART and DMA interrupts must have the same priority since both update the read position
+ */
+void 	MCAL_USART_Start_RX_DMA(USART_REGISTERS_t * USARTx,uint8_t * Buffer,uint16_t Size,void (* RX_Frame_FN)(uint16_t Offset,uint16_t Length)){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL || Buffer == NULL || Size == 0)
+	{
+		return;
+	}
+
+	USART_RX_DMA_t * RX = &Handle->RX_DMA;
+	DMA_Config_t DMA_CNFG_s;
+
+	// 1- The bytes are taken by the DMA, not by the RXNE interrupt
+	USARTx->USART_CR1 &= ~(1<<5);
+
+	RX->Size = Size;
+	RX->Last = 0;
+	RX->Received = 0;
+	RX->Released = 0;
+	RX->RX_Frame_FN = RX_Frame_FN;
+
+	// 2- Circular transfer from DR into the buffer, interrupts on half and full buffer
+	DMA_CNFG_s.Peripheral_Address = (uint32_t)&USARTx->USART_DR;
+	DMA_CNFG_s.Direction = DMA_Peripheral_To_Memory;
+	DMA_CNFG_s.Circular_EN = DMA_Enable;
+	DMA_CNFG_s.Memory_Increment_EN = DMA_Enable;
+	DMA_CNFG_s.Priority = DMA_Priority_High;
+	DMA_CNFG_s.Interrupts = DMA_IT_HT | DMA_IT_TC;
+	DMA_CNFG_s.CallBack_FN = USART_RX_DMA_Callback;
+	Global_USART_DMA_Handle[Handle->RX_DMA_Channel - 1] = Handle;
+	MCAL_DMA_Init(Handle->RX_DMA_Channel, &DMA_CNFG_s);
+	MCAL_DMA_Start(Handle->RX_DMA_Channel, (uint32_t)Buffer, Size);
+
+	// 3- DMA requests on RXNE (DMAR) and the idle line interrupt (IDLEIE) that ends a frame,
+	//    error interrupts (EIE for FE / NE / ORE, PEIE) so receive errors are counted and cleared
+	USARTx->USART_CR3 |= (1<<6) | (1<<0);
+	USARTx->USART_CR1 |= (1<<4) | (1<<8);
+	NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_RX_Release
+ * @brief 		-This Function tells the driver that reported bytes were consumed, with RTS flow control
+ * 				 RTS is asserted again once no more than RX_Low_Water bytes are left
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [in]	-Length: Number of bytes consumed, frames are released in the order they were reported
+ * @retval		-none
+ * Note			-Frames that are dropped must be released too. Can be called from a task or from RX_Frame_FN.
+ * 				 The DMA reports at least every half buffer, so RX_High_Water plus half the buffer plus what the
+ * 				 sender transmits after RTS goes high must fit in the buffer
+ */
+void 	MCAL_USART_RX_Release(USART_REGISTERS_t * USARTx,uint16_t Length){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL)
+	{
+		return;
+	}
+
+	uint8_t Channel = Handle->RX_DMA_Channel;
+
+	// Released and RTS are also updated by the USART and DMA interrupts of this instance
+	NVIC_ICER->NVIC_ICER1 = USART_IRQ_Bit(Handle->Index);
+	NVIC_ICER->NVIC_ICER0 = USART_DMA_IRQ_Bit(Channel);
+	USART_Compiler_Barrier();
+
+	Handle->RX_DMA.Released += Length;
+	USART_RX_Flow_Update(Handle);
+
+	USART_Compiler_Barrier();
+	NVIC->NVIC_ISER0 = USART_DMA_IRQ_Bit(Channel);
+	NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+}
+
+/*
+ * This function counts the bytes the DMA has written since reception started: the reported ones plus those
+ * written after the last report, which is at most half a buffer ago (the HT / TC interrupts)
+ * */
+static uint32_t USART_RX_DMA_Written(USART_Handle_t * Handle){
+
+	USART_RX_DMA_t * RX = &Handle->RX_DMA;
+	uint16_t Position = RX->Size - MCAL_DMA_Get_Counter(Handle->RX_DMA_Channel);
+
+	if(Position >= RX->Size)
+	{
+		Position = 0;
+	}
+	return RX->Received + (uint16_t)((Position + RX->Size - RX->Last) % RX->Size);
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_RX_Written
+ * @brief 		-This Function tells how many bytes the RX DMA has written into the buffer so far, including
+ * 				 the ones not reported yet
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @retval		-Bytes written since MCAL_USART_Start_RX_DMA (wraps at 2^32), 0 without RX DMA
+ * Note			-The byte received after P others is overwritten once this exceeds P + Size, so a consumer that reads
+ * 				 it after using bytes knows exactly whether they were still intact
+ */
+uint32_t MCAL_USART_RX_Written(USART_REGISTERS_t * USARTx){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	uint32_t Written;
+
+	if(Handle == NULL || Handle->RX_DMA.Size == 0)
+	{
+		return 0;
+	}
+
+	uint8_t Channel = Handle->RX_DMA_Channel;
+
+	// Received and Last are updated by the USART and DMA interrupts of this instance
+	NVIC_ICER->NVIC_ICER1 = USART_IRQ_Bit(Handle->Index);
+	NVIC_ICER->NVIC_ICER0 = USART_DMA_IRQ_Bit(Channel);
+	USART_Compiler_Barrier();
+
+	Written = USART_RX_DMA_Written(Handle);
+
+	USART_Compiler_Barrier();
+	NVIC->NVIC_ISER0 = USART_DMA_IRQ_Bit(Channel);
+	NVIC->NVIC_ISER1 = USART_IRQ_Bit(Handle->Index);
+
+	return Written;
+}
+
+/**================================================================
+ * @Fn	 		-MCAL_USART_Get_Stats
+ * @brief 		-This Function copies the receive error counters of an instance
+ * @param [in] 	-USARTx: Where x could be 1 or 2 or 3 depending on the Package
+ * @param [out]	-Stats: The counters since reset
+ * @retval		-none
+ * Note			-Errors are counted while MCAL_USART_Start_RX_DMA is used. A growing Overrun count means the link
+ * 				 is faster than the DMA / bus can take, Framing usually a wrong baud rate
+ */
+void 	MCAL_USART_Get_Stats(USART_REGISTERS_t * USARTx,USART_Stats_t * Stats){
+
+	USART_Handle_t * Handle = USART_Get_Handle(USARTx);
+	if(Handle == NULL || Stats == NULL)
+	{
+		return;
+	}
+
+	*Stats = Handle->Stats;
+}
+
+/*
+ * This function is used by the ISRs to count and clear receive errors in DMA reception. The flags are cleared by
+ * reading SR then DR: the DMA reads DR for the byte that is waiting, DR is only read here when no byte is waiting
+ * */
+static void USART_RX_Error_Service(USART_Handle_t * Handle){
+
+	USART_REGISTERS_t * USARTx = Handle->Instance;
+	uint32_t SR = USARTx->USART_SR;
+
+	if( Handle->RX_DMA.Size == 0 || !(SR & USART_RX_Errors) )
+	{
+		return;
+	}
+
+	if(SR & (1<<3))
+	{
+		Handle->Stats.Overrun++;
+	}
+	if(SR & (1<<1))
+	{
+		Handle->Stats.Framing++;
+	}
+	if(SR & (1<<2))
+	{
+		Handle->Stats.Noise++;
+	}
+	if(SR & (1<<0))
+	{
+		Handle->Stats.Parity++;
+	}
+
+	SR = USARTx->USART_SR;
+	if( (SR & USART_RX_Errors) && !(SR & (1<<5)) )
+	{
+		(void)USARTx->USART_DR;
+	}
+}
+
+/*
+ * This function is used by the ISRs to end a received frame when the line goes idle
+ * */
+static void USART_RX_Idle_Service(USART_Handle_t * Handle){
+
+	USART_REGISTERS_t * USARTx = Handle->Instance;
+
+	uint32_t SR = USARTx->USART_SR;
+
+	if( (USARTx->USART_CR1 & (1<<4)) && (SR & (1<<4)) )
+	{
+		// IDLE is cleared by reading SR then DR. A byte waiting in DR belongs to the DMA,
+		// whose read of DR clears IDLE after this SR read, so DR is only read here when RXNE is clear
+		if( !(SR & (1<<5)) )
+		{
+			(void)USARTx->USART_DR;
+		}
+		USART_RX_DMA_Service(Handle);
+	}
+}
+
+/*
+ * This function is the body of the ISRs: TX ring, receive errors, idle line, then the callback of MCAL_USART_Init
+ * */
+static void USART_IRQ_Service(USART_Handle_t * Handle){
+
+	USART_REGISTERS_t * USARTx = Handle->Instance;
+	interrupts_Bits IRQ = { ( (USARTx->USART_SR) & (0b1<<5) ) >> 5 , ( (USARTx->USART_SR) & (0b1<<6) ) >> 6 , ( (USARTx->USART_SR) & (0b1<<7) ) >> 7};
+
+	USART_TX_Service(Handle);
+	USART_RX_Error_Service(Handle);
+	USART_RX_Idle_Service(Handle);
+	if(Handle->Config.CallBack_FN != NULL)
+	{
+		Handle->Config.CallBack_FN (&IRQ);
+	}
+}
+
 //-----------------------------------------------
 //------------------<< ISR >>--------------------
 //-----------------------------------------------
 void USART1_IRQHandler(void)
 {
-	interrupts_Bits IRQ = { ( (USART1->USART_SR) & (0b1<<5) ) >> 5 , ( (USART1->USART_SR) & (0b1<<6) ) >> 6 , ( (USART1->USART_SR) & (0b1<<7) ) >> 7};
-	Global_USART_Config_s[0].CallBack_FN (&IRQ);
-}\
+	USART_IRQ_Service(&Global_USART_Handle_s[0]);
+}
 
 void USART2_IRQHandler(void)
 {
-	interrupts_Bits IRQ = { ( (USART2->USART_SR) & (0b1<<5) ) >> 5 , ( (USART2->USART_SR) & (0b1<<6) ) >> 6 , ( (USART2->USART_SR) & (0b1<<7) ) >> 7};
-	Global_USART_Config_s[1].CallBack_FN (&IRQ);
+	USART_IRQ_Service(&Global_USART_Handle_s[1]);
 }
 
-
+void USART3_IRQHandler(void)
+{
+	USART_IRQ_Service(&Global_USART_Handle_s[2]);
+}
@@ -0,0 +1,81 @@
+/*
+ * DMA_DRIVER.h
+ *
+ *  Created on: Jan 12, 2025
+ *      Author: Eng.TERA
+ */
+
+
+#ifndef INC_DMA_DRIVER_H_
+#define INC_DMA_DRIVER_H_
+
+
+//-----------------------------------------
+//-------<< INCLUDES >>--------------------
+//-----------------------------------------
+
+#include "STM32F103x8.h"
+
+//----------------------------------------------------------------
+//-------<< User type definitions (structures) >>-----------------
+//----------------------------------------------------------------
+
+typedef struct{
+
+	uint32_t Peripheral_Address;			// Address of the peripheral data register
+	uint8_t  Direction;						// Must be one of @ref DMA Direction
+	uint8_t  Circular_EN;					// Write "DMA_Enable" to restart at the start of the memory after the last byte
+	uint8_t  Memory_Increment_EN;			// Write "DMA_Enable" to enable
+	uint16_t Priority;						// Must be one of @ref DMA Priority
+	uint8_t  Interrupts;					// Any of @ref DMA Interrupts ORed together, 0 for none
+
+	void (* CallBack_FN)(uint8_t Channel,uint8_t Flags);	// Flags are the @ref DMA Interrupts that occurred
+
+}DMA_Config_t;
+
+//----------------------------------------------------------------
+//-------<< Macros Configuration References >>--------------------
+//----------------------------------------------------------------
+
+#define DMA_Enable								0x1UL
+#define DMA_Disable								0ul
+
+//@ref DMA Direction
+
+#define DMA_Peripheral_To_Memory		(0<<4)
+#define DMA_Memory_To_Peripheral		(1<<4)
+
+//@ref DMA Priority
+
+#define DMA_Priority_Low				(0x0<<12)
+#define DMA_Priority_Medium				(0x1<<12)
+#define DMA_Priority_High				(0x2<<12)
+#define DMA_Priority_Very_High			(0x3<<12)
+
+//@ref DMA Interrupts (same bits in CCR and in the callback flags)
+
+#define DMA_IT_TC						(1<<1)		// Transfer complete
+#define DMA_IT_HT						(1<<2)		// Half transfer
+#define DMA_IT_TE						(1<<3)		// Transfer error
+
+//@ref DMA1 channels of the USART requests
+
+#define DMA_USART1_TX_Channel			4
+#define DMA_USART1_RX_Channel			5
+#define DMA_USART2_TX_Channel			7
+#define DMA_USART2_RX_Channel			6
+#define DMA_USART3_TX_Channel			2
+#define DMA_USART3_RX_Channel			3
+
+
+/*
+ * ===============================================
+ * APIs Supported by "MCAL DMA DRIVER"
+ * ===============================================
+ */
+void    MCAL_DMA_Init(uint8_t Channel,DMA_Config_t * DMA_Config_s);
+void    MCAL_DMA_Start(uint8_t Channel,uint32_t Memory_Address,uint16_t Count);
+void    MCAL_DMA_Stop(uint8_t Channel);
+uint16_t MCAL_DMA_Get_Counter(uint8_t Channel);
+
+#endif /* INC_DMA_DRIVER_H_ */
@@ -48,6 +48,9 @@
 #define I2C2_BASE		0x40005800UL
 #define ADC1_BASE		0x40012400UL
 #define ADC2_BASE		0x40012800UL
+#define DMA1_BASE		0x40020000UL
+#define DWT_BASE		0xE0001000UL
+#define DEMCR_BASE		0xE000EDFCUL
 
 
 
@@ -227,6 +230,39 @@ typedef struct{
 
 }ADC_REGISTERS_t;
 
+//-*-*-*-*-*-*-*-*-*-*-*-
+//Peripheral registers: DMA
+//-*-*-*-*-*-*-*-*-*-*-*
+
+typedef struct{
+
+	volatile uint32_t DMA_CCR;
+	volatile uint32_t DMA_CNDTR;
+	volatile uint32_t DMA_CPAR;
+	volatile uint32_t DMA_CMAR;
+	volatile uint32_t RESERVED;
+
+}DMA_Channel_REGISTERS_t;
+
+typedef struct{
+
+	volatile uint32_t DMA_ISR;
+	volatile uint32_t DMA_IFCR;
+	DMA_Channel_REGISTERS_t DMA_Channel[7];		// Channel 1 is DMA_Channel[0]
+
+}DMA_REGISTERS_t;
+
+//-*-*-*-*-*-*-*-*-*-*-*-
+//Core registers: DWT (cycle counter)
+//-*-*-*-*-*-*-*-*-*-*-*
+
+typedef struct{
+
+	volatile uint32_t DWT_CTRL;
+	volatile uint32_t DWT_CYCCNT;				// Counts HCLK cycles once enabled
+
+}DWT_REGISTERS_t;
+
 
 
 //=======================================================================//
@@ -299,6 +335,19 @@ typedef struct{
 #define ADC1						((ADC_REGISTERS_t *)ADC1_BASE)
 #define ADC2						((ADC_REGISTERS_t *)ADC2_BASE)
 
+//-*-*-*-*-*-*-*-*-*-*-*-
+//Peripheral Instants: DMA
+//-*-*-*-*-*-*-*-*-*-*-*
+#define DMA1						((DMA_REGISTERS_t *)DMA1_BASE)
+
+//-*-*-*-*-*-*-*-*-*-*-*-
+//Core Instants: DWT
+//-*-*-*-*-*-*-*-*-*-*-*
+#define DWT							((DWT_REGISTERS_t *)DWT_BASE)
+#define DEMCR						(*(volatile uint32_t *)DEMCR_BASE)
+
+#define DWT_CYCCNT_EN()				do{ DEMCR |= (1<<24); DWT->DWT_CTRL |= (1<<0); }while(0)
+
 
 //=======================================================================//
 
@@ -311,6 +360,7 @@ typedef struct{
 #define I2C1_ER_IRQ				32
 #define I2C2_EV_IRQ				33
 #define I2C2_ER_IRQ				34
+#define DMA1_Channel1_IRQ		11		// Channel n is DMA1_Channel1_IRQ + n - 1
 
 
 //=======================================================================//
@@ -506,6 +556,8 @@ typedef struct{
 #define ADC1_CLOCK_EN()				RCC->RCC_APB2ENR |= (1<<9)
 #define ADC2_CLOCK_EN()				RCC->RCC_APB2ENR |= (1<<10)
 
+#define DMA1_CLOCK_EN()				RCC->RCC_AHBENR |= (1<<0)
+
 //-*-*-*-*-*-*-*-*-*-*-*-
 //clock disable Macros:
 //-*-*-*-*-*-*-*-*-*-*-*
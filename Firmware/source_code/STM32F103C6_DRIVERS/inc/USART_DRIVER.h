@@ -17,6 +17,8 @@
 #include "STM32F103x8.h"
 #include "RCC_DRIVER.h"
 #include "GPIO_DRIVER.h"
+#include "DMA_DRIVER.h"
+#include "EXTI_DRIVER.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -70,11 +72,30 @@ typedef struct {
 	Sync_t  Sync_Config_s;
 	Async_t Async_Config_s;
 	Interrupt_CNFG_t interrupts_CNFG;
+	uint8_t Flow_Control;				// Must be one of @ref Flow control
+	uint16_t RX_High_Water;				// With RTS: RTS is deasserted once this many received bytes are not released yet
+	uint16_t RX_Low_Water;				// With RTS: RTS is asserted again once no more than this many are left
 
 	void (* CallBack_FN)(interrupts_Bits *);
 
 }USART_Config_t;
 
+typedef struct{
+
+	const uint8_t * Data;
+	uint16_t Length;
+
+}USART_Segment_t;						// One piece of a message sent by MCAL_USART_WriteDMA
+
+typedef struct{
+
+	uint32_t Overrun;					// ORE: a byte arrived before the previous one was read (it is lost)
+	uint32_t Framing;					// FE: no stop bit, usually a wrong baud rate or a break
+	uint32_t Noise;						// NE
+	uint32_t Parity;					// PE
+
+}USART_Stats_t;							// Receive errors counted by the ISR, see MCAL_USART_Get_Stats
+
 //----------------------------------------------------------------
 //-------<< Macros Configuration References >>--------------------
 //----------------------------------------------------------------
@@ -100,6 +121,26 @@ typedef struct {
 #define Even							(0<<9)
 #define Odd								(1<<9)
 
+//@ref Flow control
+
+#define USART_Flow_None					0
+#define USART_Flow_RTS					(1<<0)		// RTS follows the fill level of the RX DMA buffer, see MCAL_USART_RX_Release
+#define USART_Flow_CTS					(1<<1)		// The transmitter waits while CTS is high
+#define USART_Flow_RTS_CTS				(USART_Flow_RTS | USART_Flow_CTS)
+
+//@ref Baud rate
+
+#define USART_BAUD_MAX_ERROR_PPM		20000	// Rates whose actual value is off by more than 2% are rejected
+
+//@ref Auto baud
+
+#define USART_AUTO_BAUD_EDGES			6		// Edges of a '{' (0x7B) up to its stop bit
+#define USART_AUTO_BAUD_SNAP_PPM		30000	// A measured rate must be within 3% of a standard one, which is then set
+
+//@ref TX ring buffer
+
+#define USART_TX_BUFFER_SIZE			128		// Bytes queued per instance by MCAL_USART_Write, must be a power of two
+
 
 /*
  * ===============================================
@@ -113,5 +154,17 @@ void    MCAL_USART_SendChar(USART_REGISTERS_t * USARTx,char Buffer);
 void 	MCAL_USART_GPIO_Pins_Config(USART_REGISTERS_t * USARTx);
 void 	sendJSON(USART_REGISTERS_t *USARTx, char *jsonData);
 void 	receiveJSON(USART_REGISTERS_t *USARTx, char *buffer, uint32_t bufferSize);
+uint8_t MCAL_USART_Set_Baud_Rate(USART_REGISTERS_t * USARTx,uint32_t Baud_Rate);
+uint16_t MCAL_USART_Calculate_BRR(uint32_t PCLK,uint32_t Baud_Rate,uint32_t * Error_PPM);
+void 	MCAL_USART_Start_Auto_Baud(USART_REGISTERS_t * USARTx,void (* Auto_Baud_FN)(uint32_t Baud_Rate));
+uint16_t MCAL_USART_Auto_Baud_BRR(const uint32_t * Edge_Times,uint32_t HCLK,uint32_t PCLK,uint32_t * Baud_Rate);
+uint32_t MCAL_USART_Write(USART_REGISTERS_t * USARTx,const uint8_t * Buffer,uint32_t Length);
+void 	MCAL_USART_Set_TX_Complete_Callback(USART_REGISTERS_t * USARTx,void (* TX_Complete_FN)(void));
+uint8_t MCAL_USART_WriteDMA(USART_REGISTERS_t * USARTx,const USART_Segment_t * Segments,uint8_t Count);
+uint8_t MCAL_USART_TX_Busy(USART_REGISTERS_t * USARTx);
+void 	MCAL_USART_Start_RX_DMA(USART_REGISTERS_t * USARTx,uint8_t * Buffer,uint16_t Size,void (* RX_Frame_FN)(uint16_t Offset,uint16_t Length));
+void 	MCAL_USART_RX_Release(USART_REGISTERS_t * USARTx,uint16_t Length);
+uint32_t MCAL_USART_RX_Written(USART_REGISTERS_t * USARTx);
+void 	MCAL_USART_Get_Stats(USART_REGISTERS_t * USARTx,USART_Stats_t * Stats);
 
 #endif /* INC_USART_DRIVER_H_ */
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Binary framing of the command link, see cobs_frame.h
+ ******************************************************************************
+ */
+
+#include "cobs_frame.h"
+
+// CRC16 CCITT (polynomial 0x1021) of every 4 bit value, the CRC is updated a nibble at a time
+static const uint16_t crc16Nibbles[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+// Encoder state: where the code byte of the current block goes and how many bytes the block has
+typedef struct {
+	uint8_t *out;
+	uint16_t length;
+	uint16_t codeIndex;
+	uint8_t code;
+} CobsEncoder;
+
+// Continue the CRC of a frame over more bytes, start with COBS_FRAME_CRC_INIT
+uint16_t crc16Ccitt(uint16_t crc, const uint8_t *data, uint16_t length) {
+	while (length-- > 0) {
+		crc = (uint16_t)((crc << 4) ^ crc16Nibbles[(crc >> 12) ^ (*data >> 4)]);
+		crc = (uint16_t)((crc << 4) ^ crc16Nibbles[(crc >> 12) ^ (*data & 0x0F)]);
+		data++;
+	}
+	return crc;
+}
+
+// Add one byte to the encoded frame, a zero (or a full block) ends the current block
+static void cobsEncodeByte(CobsEncoder *encoder, uint8_t byte) {
+	if (byte != 0) {
+		encoder->out[encoder->length++] = byte;
+		encoder->code++;
+	}
+	if (byte == 0 || encoder->code == 0xFF) {
+		encoder->out[encoder->codeIndex] = encoder->code;
+		encoder->codeIndex = encoder->length++;
+		encoder->code = 1;
+	}
+}
+
+// Encode type, payload and CRC into out (COBS_FRAME_MAX_ENCODED bytes), returns the length including the 0x00 delimiter
+uint16_t cobsEncodeFrame(uint8_t type, const uint8_t *payload, uint16_t length, uint8_t *out) {
+	CobsEncoder encoder = { out, 1, 0, 1 };
+	uint16_t crc = crc16Ccitt(COBS_FRAME_CRC_INIT, &type, 1);
+
+	if (length > COBS_FRAME_MAX_PAYLOAD) {
+		return 0;
+	}
+	crc = crc16Ccitt(crc, payload, length);
+
+	cobsEncodeByte(&encoder, type);
+	for (uint16_t i = 0; i < length; i++) {
+		cobsEncodeByte(&encoder, payload[i]);
+	}
+	cobsEncodeByte(&encoder, (uint8_t)(crc >> 8));
+	cobsEncodeByte(&encoder, (uint8_t)crc);
+
+	// The last block has no zero after it
+	out[encoder.codeIndex] = encoder.code;
+	out[encoder.length++] = 0;
+	return encoder.length;
+}
+
+// Forget the frame being decoded, the next byte starts a new one
+void cobsDecoderInit(CobsDecoder *decoder) {
+	decoder->length = 0;
+	decoder->code = 0;
+	decoder->remaining = 0;
+}
+
+// Decode one received byte, the frame is checked when its 0x00 delimiter arrives
+CobsFrameResult cobsDecoderPush(CobsDecoder *decoder, uint8_t byte) {
+	if (byte == 0) {
+		CobsFrameResult result = COBS_FRAME_ERROR;
+
+		if (decoder->code == 0) {
+			// Delimiters between frames (the host may send one first to resynchronize)
+			result = COBS_FRAME_NONE;
+		}
+		else if (decoder->remaining == 0 && decoder->length >= 3
+				&& crc16Ccitt(COBS_FRAME_CRC_INIT, decoder->data, decoder->length) == 0) {
+			// Running the CRC over the frame and its big endian CRC leaves 0
+			result = COBS_FRAME_OK;
+		}
+
+		// The decoded bytes stay readable until the next frame starts
+		decoder->code = 0;
+		decoder->remaining = 0;
+		return result;
+	}
+
+	if (decoder->code == 0) {
+		// First code byte of a frame
+		decoder->length = 0;
+		decoder->code = byte;
+		decoder->remaining = byte - 1;
+		return COBS_FRAME_NONE;
+	}
+
+	// A frame that does not fit is dropped at once and decoding starts over with the next byte,
+	// so that a stream without delimiters (e.g. JSON text) is reported as errors as well
+	if (decoder->length == COBS_FRAME_MAX_DECODED) {
+		decoder->code = 0;
+		decoder->remaining = 0;
+		return COBS_FRAME_ERROR;
+	}
+
+	if (decoder->remaining == 0) {
+		// Next code byte: a block shorter than 254 bytes stood for a zero, unless it was the last one
+		if (decoder->code != 0xFF) {
+			decoder->data[decoder->length++] = 0;
+		}
+		decoder->code = byte;
+		decoder->remaining = byte - 1;
+	}
+	else {
+		decoder->data[decoder->length++] = byte;
+		decoder->remaining--;
+	}
+	return COBS_FRAME_NONE;
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Command dispatcher, see command_table.h
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "command_table.h"
+
+// Names of the command codes
+const char commandNames[CMD_COUNT][4] = {
+	[CMD_ENA] = "ENA",
+	[CMD_DIS] = "DIS",
+	[CMD_ACT] = "ACT",
+	[CMD_STA] = "STA",
+	[CMD_DUR] = "DUR",
+	[CMD_BAU] = "BAU",
+	[CMD_LNK] = "LNK",
+	[CMD_ABD] = "ABD",
+	[CMD_BIN] = "BIN",
+	[CMD_JSN] = "JSN"
+};
+
+// Letters of every command, one X(code, c0, c1, c2) each
+#define COMMAND_LETTERS(X)		\
+	X(CMD_ENA, 'E', 'N', 'A')	\
+	X(CMD_DIS, 'D', 'I', 'S')	\
+	X(CMD_ACT, 'A', 'C', 'T')	\
+	X(CMD_STA, 'S', 'T', 'A')	\
+	X(CMD_DUR, 'D', 'U', 'R')	\
+	X(CMD_BAU, 'B', 'A', 'U')	\
+	X(CMD_LNK, 'L', 'N', 'K')	\
+	X(CMD_ABD, 'A', 'B', 'D')	\
+	X(CMD_BIN, 'B', 'I', 'N')	\
+	X(CMD_JSN, 'J', 'S', 'N')
+
+// A new command needs a name whose slot is still free: the slot bits only add up to their OR when no two are the same
+#define COMMAND_SLOT_BIT(code, c0, c1, c2) + (1u << COMMAND_HASH(c0, c1, c2))
+#define COMMAND_SLOT_OR(code, c0, c1, c2) | (1u << COMMAND_HASH(c0, c1, c2))
+_Static_assert((0 COMMAND_LETTERS(COMMAND_SLOT_BIT)) == (0 COMMAND_LETTERS(COMMAND_SLOT_OR)), "Two command names share a hash slot (COMMAND_HASH)");
+
+// Command code + 1 of every hash slot, 0 for the free ones
+#define COMMAND_SLOT(code, c0, c1, c2) [COMMAND_HASH(c0, c1, c2)] = (code) + 1,
+static const uint8_t commandSlots[COMMAND_HASH_SIZE] = {
+	COMMAND_LETTERS(COMMAND_SLOT)
+};
+
+// Same handler whatever the node ID is
+#define ANY_NODE(handler, doneType) { { handler, doneType }, { handler, doneType }, { handler, doneType } }
+
+// Handler of every command for every type of node
+static const CommandEntry commandTable[CMD_COUNT][NODE_TYPE_COUNT] = {
+	[CMD_ENA] = {
+		[NODE_TYPE_SENSOR] = { enableSensor, "NS" },
+		[NODE_TYPE_ACTUATOR] = { enableActuator, "NA" }
+	},
+	[CMD_DIS] = {
+		[NODE_TYPE_SENSOR] = { disableSensor, "NS" },
+		[NODE_TYPE_ACTUATOR] = { disableActuator, "NA" }
+	},
+	[CMD_ACT] = {
+		[NODE_TYPE_ACTUATOR] = { setActuator, NULL }
+	},
+	[CMD_STA] = {
+		[NODE_TYPE_SENSOR] = { reportNodeStatus, NULL },
+		[NODE_TYPE_ACTUATOR] = { reportNodeStatus, NULL }
+	},
+	[CMD_DUR] = {
+		[NODE_TYPE_SENSOR] = { setSensorPeriod, NULL }
+	},
+	[CMD_BAU] = ANY_NODE(setBaudRate, NULL),
+	[CMD_LNK] = ANY_NODE(reportLinkStatus, NULL),
+	[CMD_ABD] = ANY_NODE(detectBaudRate, "SYS"),
+	[CMD_BIN] = ANY_NODE(selectBinaryFraming, NULL),
+	[CMD_JSN] = ANY_NODE(selectJsonFraming, "SYS")
+};
+
+// Command code of a command name, CMD_UNKNOWN if it is not one
+uint8_t commandCodeOf(const char *command) {
+	uint8_t slot;
+
+	if (command[0] == '\0' || command[1] == '\0' || command[2] == '\0' || command[3] != '\0') {
+		return CMD_UNKNOWN;
+	}
+
+	// One hash and one compare, however many commands there are
+	slot = commandSlots[COMMAND_HASH(command[0], command[1], command[2])];
+	if (slot == 0 || memcmp(commandNames[slot - 1], command, 3) != 0) {
+		return CMD_UNKNOWN;
+	}
+	return slot - 1;
+}
+
+// Table entry of a command for the node in a registry slot, NULL for an unknown command
+static const CommandEntry *commandEntry(uint8_t commandCode, uint8_t slot) {
+	if (commandCode >= CMD_COUNT) {
+		return NULL;
+	}
+	return &commandTable[commandCode][(slot == NODE_NOT_FOUND) ? NODE_TYPE_NONE : nodeConfig(slot)->type];
+}
+
+// Table entry of a command for a node ID, NULL for an unknown command
+const CommandEntry *commandLookup(uint8_t commandCode, int nodeID) {
+	return commandEntry(commandCode, nodeFind(nodeID));
+}
+
+// Execute one decoded command, whichever framing it came in
+void dispatchCommand(const JsonMessage *jsonMsg) {
+	uint8_t slot = nodeFind(jsonMsg->nodeID);
+	const CommandEntry *entry = commandEntry(jsonMsg->commandCode, slot);
+
+	if (entry == NULL || entry->handler == NULL) {
+		return;
+	}
+	if (entry->doneType != NULL) {
+		sendNodeMessage(entry->doneType, jsonMsg->nodeID, NODE_TEXT("DONE"));
+	}
+	entry->handler(jsonMsg, slot);
+}
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Deadline min-heap, see deadline_heap.h
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include "deadline_heap.h"
+
+void deadlineHeapInit(DeadlineHeap *heap) {
+	heap->count = 0;
+}
+
+// Add a node, returns 0 if the heap is full
+uint8_t deadlineHeapPush(DeadlineHeap *heap, uint8_t slot, uint32_t due) {
+	uint8_t child = heap->count;
+
+	if (heap->count >= NODE_MAX) {
+		return 0;
+	}
+	heap->count++;
+
+	// Move the parents that are due later down until the new entry fits
+	while (child > 0) {
+		uint8_t parent = (child - 1) / 2;
+
+		if (!DEADLINE_BEFORE(due, heap->entries[parent].due)) {
+			break;
+		}
+		heap->entries[child] = heap->entries[parent];
+		child = parent;
+	}
+	heap->entries[child].due = due;
+	heap->entries[child].slot = slot;
+	return 1;
+}
+
+// Earliest entry, NULL if the heap is empty
+const Deadline *deadlineHeapTop(const DeadlineHeap *heap) {
+	return (heap->count > 0) ? &heap->entries[0] : NULL;
+}
+
+// Remove the earliest entry
+void deadlineHeapPop(DeadlineHeap *heap) {
+	Deadline last;
+	uint8_t parent = 0;
+
+	if (heap->count == 0) {
+		return;
+	}
+	last = heap->entries[--heap->count];
+
+	// Move the earlier child up until the last entry fits into the hole
+	while (2 * parent + 1 < heap->count) {
+		uint8_t child = 2 * parent + 1;
+
+		if (child + 1 < heap->count && DEADLINE_BEFORE(heap->entries[child + 1].due, heap->entries[child].due)) {
+			child++;
+		}
+		if (!DEADLINE_BEFORE(heap->entries[child].due, last.due)) {
+			break;
+		}
+		heap->entries[parent] = heap->entries[child];
+		parent = child;
+	}
+	heap->entries[parent] = last;
+}
@@ -11,16 +11,17 @@
 #include "semphr.h"
 #include <string.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include "STM32F103x8.h"
 #include "GPIO_DRIVER.h"
 #include "USART_DRIVER.h"
 #include "cJSON.h"
+#include "cJSON_Push.h"
+#include "cJSON_Writer.h"
 #include "ADC.h"
-
-// Declare handles for the UART and sensor tasks, as well as a notification value
-TaskHandle_t uartTaskHandle = NULL;
-TaskHandle_t sensorTaskHandle = NULL;
+#include "cobs_frame.h"
+#include "node_registry.h"
+#include "command_table.h"
+#include "deadline_heap.h"
 
 // Define node IDs for sensors and actuators to be used in the system
 #define TEMP_SENSOR_NODE_ID 128
@@ -28,13 +29,33 @@ TaskHandle_t sensorTaskHandle = NULL;
 #define RELAY_ACTUATOR_NODE_ID 80
 #define QUEUE_LENGTH 10 // Define the maximum number of items that the queue can hold
 #define QUEUE_ITEM_SIZE sizeof(JsonMessage) // Define the size of each queue item (a JsonMessage)
-
-// Structure to represent JSON message data, including command, node ID, and data payload
-typedef struct {
-	char command[64];  // Command to be executed by the system
-	int nodeID;        // Unique identifier for the node (sensor/actuator)
-	char data[32];     // Additional data associated with the command
-} JsonMessage;
+#define RX_DMA_BUFFER_SIZE 256 // Circular buffer the USART receive DMA writes into, bytes are lost once the DMA gets a whole buffer ahead of the UART task
+#define RX_BURST_STAMPS 8 // Bursts whose end time is kept until the UART task decoded them, a power of two
+#define UART_FLOW_CONTROL USART_Flow_None // USART_Flow_RTS_CTS when the RTS (PA12) and CTS (PA11) lines of the gateway are wired
+#define UART_RX_HIGH_WATER (RX_DMA_BUFFER_SIZE / 4) // Undecoded bytes at which RTS stops the gateway, leaves a quarter buffer for bytes it sends after that
+#define UART_RX_LOW_WATER (RX_DMA_BUFFER_SIZE / 8) // Undecoded bytes at which RTS lets it send again
+#define UART_DEFAULT_BAUD_RATE 9600 // Baud rate of the replies until the first command is measured, the BAU command changes it at runtime
+#define LINK_JSON 0   // Commands and reports are JSON text (after reset)
+#define LINK_BINARY 1 // Commands and reports are COBS frames with a CRC16, see cobs_frame.h
+#define LINK_MAGIC "COBS1" // Data of the BIN command that switches the link to binary frames
+#define LINK_MAX_FRAME_ERRORS 3 // Bad binary frames in a row after which the link falls back to JSON (e.g. the gateway restarted)
+#define FRAME_TEXT 0x10     // Report frame types: payload kind in the high nibble, node type (1 NS, 2 NA, 3 SYS) in the low one
+#define FRAME_READING 0x20  // Payload: node ID, 32 bit little endian value, unit text
+#define FRAME_COUNTERS 0x30 // Payload: node ID, 32 bit little endian counters
+#define NOTIFY_FRAME_READY (1UL << 0)    // Notification bits of the tasks. UART task: the receive DMA reported new bytes
+#define NOTIFY_NODE_ENABLE (1UL << 1)    // Sampler and actuator task: a node was enabled (ENA)
+#define NOTIFY_NODE_DISABLE (1UL << 2)   // Sampler and actuator task: a node was disabled (DIS)
+#define NOTIFY_PERIOD_CHANGED (1UL << 3) // Sampler task: the readings of a sensor were started or their period changed (DUR)
+#define NOTIFY_OUTPUT_CHANGED (1UL << 4) // Actuator task: the output of an actuator was set (ACT)
+#define NOTIFY_NODE_EVENTS (NOTIFY_NODE_ENABLE | NOTIFY_NODE_DISABLE | NOTIFY_PERIOD_CHANGED | NOTIFY_OUTPUT_CHANGED)
+
+// Schema of the JsonMessage fields, incoming members are decoded straight into the struct
+static const cJSON_PushField jsonMessageFields[] = {
+	cJSON_PushFieldOf("command", cJSON_String, JsonMessage, command),
+	cJSON_PushFieldOf("nodeID", cJSON_Number, JsonMessage, nodeID),
+	cJSON_PushFieldOf("data", cJSON_String, JsonMessage, data)
+};
+#define JSON_FIELD_COMMAND (1UL << 0) // A message without a command is dropped
 
 // Enum to represent possible GPIO ports for relay control
 typedef enum {
@@ -49,70 +70,110 @@ typedef enum {
 	USART_2
 } USART_NUM_t;
 
-// RTOS Handlers and synchronization objects (semaphores and queues)
-xQueueHandle xQueueHandel = NULL;    // Queue handle for communication between tasks
-SemaphoreHandle_t xJsonSemaphore;    // Semaphore for JSON message processing synchronization
-SemaphoreHandle_t USARTSemaphore = NULL; // Semaphore for USART access synchronization
-SemaphoreHandle_t relaySemaphore = NULL; // Semaphore for relay task synchronization
-SemaphoreHandle_t tempSensorSemaphore = NULL; // Semaphore for temperature sensor task synchronization
-SemaphoreHandle_t lightSensorSemaphore = NULL; // Semaphore for light sensor task synchronization
-
+// RTOS Handlers and synchronization objects (the tasks are signalled with notification bits, see NOTIFY_*)
 QueueHandle_t xJsonQueue;  // Queue to store JSON messages
-TaskHandle_t xTempTaskHandle = NULL; // Handle for temperature sensor task
 TaskHandle_t xUartTaskHandle = NULL; // Handle for UART command task
-SemaphoreHandle_t xUartMutex; // Mutex for UART communication
+TaskHandle_t xSamplerTaskHandle = NULL; // Handle for the sampler task, the only one driving the sensors
+TaskHandle_t xActuatorTaskHandle = NULL; // Handle for the actuator task, the only one driving the actuators
+SemaphoreHandle_t xUartMutex = NULL; // Mutex for UART communication, held while a reply or report is sent
 
 // Global variables for node control and sensor data
-static int counter = 0;      // Counter for processing UART data
-
-char jsonBuffer[64];         // Buffer to store incoming JSON data
-int tempSensorDuration = 2;  // Duration (in seconds) between temperature sensor readings
-int lightSensorDuration = 2; // Duration (in seconds) between light sensor readings
-uint8_t relayStatus = 0;     // Relay status: 0 = OFF, 1 = ON
-uint8_t relayLastStatus = 0; // Last known relay status for state tracking
-char num[10];                // Buffer for ADC result
-int analog_rx_temperature = 0; // Variable to store the temperature reading
-int analog_rx_light = 0;     // Variable to store the light sensor reading
+static uint8_t rxDmaBuffer[RX_DMA_BUFFER_SIZE]; // Received bytes, written by DMA
+static volatile uint32_t rxStreamHead; // Number of bytes received so far
+static volatile uint8_t autoBaudPending; // Set when auto baud detection consumed the '{' of the next command
+volatile uint32_t rxOverwrites; // Times the DMA overwrote bytes before they were decoded ("OVW" in LNK), each one discards the commands they were part of
+// End of a burst of received bytes: its position in the received byte stream and the DWT cycle count when the
+// receive DMA reported it (the line went idle), the time a command ending within the burst was received
+typedef struct {
+	uint32_t streamEnd;
+	uint32_t cycles;
+} RxBurstStamp;
+static RxBurstStamp rxBurstStamps[RX_BURST_STAMPS]; // Written by the DMA callback, rxBurstCount % RX_BURST_STAMPS is the next one
+static volatile uint32_t rxBurstCount; // Bursts reported so far
+static uint32_t rxBurstTail; // Oldest burst the UART task may still look up
+static uint32_t rxDecodePosition; // Stream position of the first byte the UART task is feeding to the tokenizer
+static volatile uint32_t actuationStartCycles; // frameEndCycles of the last ACT, until the actuator task drives its pin
+static volatile uint8_t actuationPending; // Set by ACT, cleared by the actuator task
+volatile uint32_t actuationLatency; // CPU (HCLK) cycles from the end of the frame of the last ACT to its GPIO write
+volatile uint32_t actuationLatencyMax; // Longest actuationLatency since reset
+static cJSON_PushParser jsonPushParser; // Tokenizer fed with the received frames by the UART task
+static JsonMessage rxJsonMsg;           // Command being decoded from the incoming bytes
+static cJSON_PushRecord rxJsonRecord;   // Decodes the tokenizer members into rxJsonMsg
+static CobsDecoder rxCobsDecoder;       // Decodes the received frames in binary mode
+static uint8_t rxFrameErrors;           // Bad binary frames in a row
+static volatile uint8_t linkMode = LINK_JSON; // Framing of the commands and reports, changed with xUartMutex held
+
+// Drivers of the node types (device, port and pin come from the NodeConfig)
+void adcSensorEnable(const NodeConfig *config);
+void adcSensorDisable(const NodeConfig *config);
+uint8_t adcSensorRead(const NodeConfig *config, int *value);
+uint8_t lm35SensorRead(const NodeConfig *config, int *value);
+void gpioActuatorEnable(const NodeConfig *config);
+void gpioActuatorDisable(const NodeConfig *config);
+void gpioActuatorWrite(const NodeConfig *config, int value);
+
+static const NodeOps lm35SensorOps = { adcSensorEnable, adcSensorDisable, lm35SensorRead, NULL };   // LM35 on an ADC input, reports °C
+static const NodeOps adcSensorOps = { adcSensorEnable, adcSensorDisable, adcSensorRead, NULL };     // Raw ADC reading (LDR)
+static const NodeOps gpioActuatorOps = { gpioActuatorEnable, gpioActuatorDisable, NULL, gpioActuatorWrite }; // Active low open drain output (relay)
+
+// Nodes of the system: ID, type, driver, ADC, port, pin, seconds between readings, unit and its length.
+// More ADC sensors and GPIO actuators are added here (up to NODE_MAX), all sensors are read by the sampler task.
+static const NodeConfig nodeConfigs[] = {
+	{ TEMP_SENSOR_NODE_ID, NODE_TYPE_SENSOR, &lm35SensorOps, 1, PA, 0, 2, NODE_TEXT("°C") },
+	{ LIGHT_SENSOR_NODE_ID, NODE_TYPE_SENSOR, &adcSensorOps, 2, PA, 1, 2, NODE_TEXT("") },
+	{ RELAY_ACTUATOR_NODE_ID, NODE_TYPE_ACTUATOR, &gpioActuatorOps, 0, PORTB, 5, 0, NODE_TEXT("") }
+};
+#define NODE_COUNT (sizeof(nodeConfigs) / sizeof(nodeConfigs[0]))
+_Static_assert(NODE_COUNT <= NODE_MAX, "More nodes than the registry holds (NODE_MAX)");
+static NodeState nodeStates[NODE_COUNT]; // NODE_COUNT * sizeof(NodeState) bytes of RAM, .bss.nodeStates in the .map file
 
 // Function Prototypes for initialization and task handling
 void RELAY_Init(RELAY_GPIO_PORT_t port, char pin_num_signal);
 void RELAY_DeInit(RELAY_GPIO_PORT_t port, char pin_num_signal);
 void UART_Init(USART_NUM_t uart_num);
-void Usart_callback(interrupts_Bits *);
+void Usart_auto_baud_callback(uint32_t baudRate);
+void Usart_frame_callback(uint16_t offset, uint16_t length);
+void JsonPush_callback(const cJSON_PushParser *parser, cJSON_PushEvent event, void *user_data);
+void Usart_sink(const unsigned char *data, size_t length, void *user_data);
+void sendNodeReading(const NodeConfig *config, int value);
+void sendLinkStatus(int nodeID);
+void setLinkMode(uint8_t mode);
 
 // FreeRTOS task functions
 void uartTask(void *pvParameters); // Task to handle UART communication
-void sensorTask(void *pvParameters); // Task to handle sensor data collection
-void lightsensorTask(void *pvParameters); // Task for light sensor data collection
-void relayTask(void *pvParameters); // Task to manage relay control
-void JsonProcessingTask(void *pvParameters); // Task for processing JSON data
+void samplerTask(void *pvParameters); // Task to read the sensor nodes when their readings are due
+void actuatorTask(void *pvParameters); // Task to drive the actuator nodes
 
 // Main entry point for the application
 int main(void) {
 	AFIO_CLOCK_EN(); // Enable AFIO clock for alternate function I/O
 	USART1_CLOCK_EN(); // Enable USART1 clock
+	DWT_CYCCNT_EN(); // Cycle counter for the actuation latency
 
-	// Initialize UART for communication
-	UART_Init(USART_1);
-
-	// Create binary semaphores for synchronization between tasks
-	xJsonSemaphore = xSemaphoreCreateBinary();
-	USARTSemaphore = xSemaphoreCreateBinary();
-	relaySemaphore = xSemaphoreCreateBinary();
-	tempSensorSemaphore = xSemaphoreCreateBinary();
-	lightSensorSemaphore = xSemaphoreCreateBinary();
+	// Create the mutex that keeps the replies and reports of the tasks from mixing on the USART
+	xUartMutex = xSemaphoreCreateMutex();
 
-	xSemaphoreGive(USARTSemaphore); // Give the USART semaphore to allow UART communication
+	// Register the nodes, each one starts disabled (powered down, sensors are not active).
+	// A repeated ID in nodeConfigs ends the registration, so the nodes after it would never be served: stop here instead
+	if (nodeRegistryInit(nodeConfigs, nodeStates, NODE_COUNT) != NODE_COUNT) {
+		while (1) { /* nodeConfigs has a repeated node ID */ }
+	}
 
 	// Create a queue to hold JSON messages with specified length and item size
 	xJsonQueue = xQueueCreate(QUEUE_LENGTH, QUEUE_ITEM_SIZE);
 
-	// Create tasks for UART communication, JSON processing, and sensor reading
+	// Decode incoming commands as their bytes arrive
+	cJSON_PushRecordInit(&rxJsonRecord, jsonMessageFields, sizeof(jsonMessageFields) / sizeof(jsonMessageFields[0]), &rxJsonMsg);
+	cJSON_PushInit(&jsonPushParser, JsonPush_callback, &rxJsonRecord);
+	cobsDecoderInit(&rxCobsDecoder);
+
+	// Initialize UART for communication once the queue it feeds exists
+	UART_Init(USART_1);
+
+	// Create tasks for UART communication and sensor reading
 	xTaskCreate(uartTask, "UART_Task", 450, NULL, 3, &xUartTaskHandle);
-	xTaskCreate(JsonProcessingTask, "JSON Processor", 400, NULL, 3, NULL);
-	xTaskCreate(sensorTask, "Sensor_Task", 200, NULL, 2, &xTempTaskHandle);
-	xTaskCreate(lightsensorTask, "Light_Sensor_Task", 200, NULL, 2, NULL);
-	xTaskCreate(relayTask, "Relay_Task", 128, NULL, 1, NULL); // Reduced stack size for relay task
+	xTaskCreate(samplerTask, "Sampler_Task", 200, NULL, 2, &xSamplerTaskHandle);
+	xTaskCreate(actuatorTask, "Actuator_Task", 128, NULL, 4, &xActuatorTaskHandle); // Reduced stack size for actuator task, highest priority so ACT preempts the UART task
 
 	// Start the FreeRTOS scheduler to begin task execution
 	vTaskStartScheduler();
@@ -121,50 +182,299 @@ int main(void) {
 	while (1) { /* Infinite loop to keep the main function alive */ }
 }
 
-// USART callback function for handling incoming data
-void Usart_callback(interrupts_Bits * irq) {
-	// Receive a character from USART and store it in the buffer
-	MCAL_USART_ReceiveChar(USART1, jsonBuffer + counter);
+// Auto baud callback, runs in the interrupt once the '{' starting a command has been measured and the receiver is back on
+void Usart_auto_baud_callback(uint32_t baudRate) {
+	(void)baudRate;
+	autoBaudPending = 1;
+}
+
+// USART receive DMA callback, runs in the interrupt once per burst of bytes (line idle or buffer half full)
+void Usart_frame_callback(uint16_t offset, uint16_t length) {
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	// The bytes follow the ones reported before (offset is rxStreamHead modulo the buffer size), the UART task
+	// decodes everything up to rxStreamHead, so several bursts are handled by one wakeup and none can be lost.
+	// The bursts are contiguous in rxDmaBuffer, so a queue of (offset, length) descriptors would only say again what
+	// rxStreamHead says and could only run full when the buffer does: what is lost then is the bytes the DMA wrote
+	// over, which the UART task counts exactly from the DMA position (rxOverwrites)
+	// The stamp is written before rxStreamHead covers the burst, so the UART task finds it for any byte it decodes
+	(void)offset;
+	rxBurstStamps[rxBurstCount % RX_BURST_STAMPS].streamEnd = rxStreamHead + length;
+	rxBurstStamps[rxBurstCount % RX_BURST_STAMPS].cycles = DWT->DWT_CYCCNT;
+	rxBurstCount++;
+	rxStreamHead += length;
+	if (xUartTaskHandle != NULL) {
+		xTaskNotifyFromISR(xUartTaskHandle, NOTIFY_FRAME_READY, eSetBits, &xHigherPriorityTaskWoken);
+	}
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// DWT cycle count at the end of the burst that received the byte at a stream position, called by the UART task
+// with increasing positions. Only the last RX_BURST_STAMPS bursts are kept: when more were waiting the oldest
+// one kept is used, which makes the latency of that command look shorter than it was
+static uint32_t rxReceivedCycles(uint32_t position) {
+	uint32_t cycles;
+
+	taskENTER_CRITICAL();
+	if (rxBurstCount - rxBurstTail > RX_BURST_STAMPS) {
+		rxBurstTail = rxBurstCount - RX_BURST_STAMPS;
+	}
+	while (rxBurstCount - rxBurstTail > 1 && (int32_t)(rxBurstStamps[rxBurstTail % RX_BURST_STAMPS].streamEnd - position) <= 0) {
+		rxBurstTail++;
+	}
+	cycles = rxBurstStamps[rxBurstTail % RX_BURST_STAMPS].cycles;
+	taskEXIT_CRITICAL();
+	return cycles;
+}
+
+// JSON tokenizer callback, runs in the UART task for every decoded member of a command
+void JsonPush_callback(const cJSON_PushParser *parser, cJSON_PushEvent event, void *user_data) {
+	cJSON_PushRecord *record = (cJSON_PushRecord *)user_data;
+	JsonMessage *jsonMsg = (JsonMessage *)record->target;
+
+	if (event == cJSON_PushMember) {
+		// Store the member in its field of the message (wrong types and overlong values are flagged as errors)
+		cJSON_PushRecordMember(record, parser);
+		return;
+	}
+
+	// The closing brace arrived: queue a well formed command, it is handled once the frame is decoded
+	if (event == cJSON_PushObjectEnd && cJSON_PushRecordComplete(record, JSON_FIELD_COMMAND)) {
+		jsonMsg->commandCode = commandCodeOf(jsonMsg->command);
+		jsonMsg->frameEndCycles = rxReceivedCycles(rxDecodePosition + (uint32_t)parser->offset);
+		xQueueSend(xJsonQueue, jsonMsg, 0);
+	}
 
-	// Handle the case when the received buffer is not a valid JSON message
-	if (jsonBuffer[0] != '{') {
-		counter = 0; // Reset counter if not a JSON start character
+	// Start the next command from a clean message (also drops a malformed one)
+	memset(jsonMsg, 0, sizeof(JsonMessage));
+	cJSON_PushRecordReset(record);
+}
+
+// JSON writer sink that sends the text straight out of USART1
+void Usart_sink(const unsigned char *data, size_t length, void *user_data) {
+	// Queue the text for the TX interrupt, only wait when the ring is full
+	while (length > 0) {
+		uint32_t queued = MCAL_USART_Write(USART1, data, length);
+		data += queued;
+		length -= queued;
+		if (length > 0) {
+			vTaskDelay(1);
+		}
 	}
-	// If a complete JSON message is received
-	else if (jsonBuffer[counter] == '}') {
-		jsonBuffer[counter + 1] = '\0'; // Null-terminate the string
-		counter = 0; // Reset counter for next message
+}
+
+// Encode a binary report and send it, the caller holds xUartMutex
+static void writeBinaryFrame(uint8_t type, const uint8_t *payload, uint16_t length) {
+	uint8_t frame[COBS_FRAME_MAX_ENCODED];
 
-		// Signal the JSON processing task that a new message is available
-		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-		xSemaphoreGiveFromISR(xJsonSemaphore, &xHigherPriorityTaskWoken);
+	Usart_sink(frame, cobsEncodeFrame(type, payload, length, frame), NULL);
+}
 
-		// Request a context switch if a higher priority task is woken up
-		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+// Frame type of a report: payload kind and node type
+static uint8_t binaryFrameType(uint8_t kind, const char *nodeType) {
+	if (strcmp(nodeType, "NS") == 0) {
+		return kind | 1;
 	}
-	else {
-		counter++; // Increment counter to store the next character in the buffer
+	if (strcmp(nodeType, "NA") == 0) {
+		return kind | 2;
+	}
+	return kind | 3;
+}
+
+// Store a 32 bit value little endian, returns the number of bytes written
+static uint16_t putUint32(uint8_t *out, uint32_t value) {
+	out[0] = (uint8_t)value;
+	out[1] = (uint8_t)(value >> 8);
+	out[2] = (uint8_t)(value >> 16);
+	out[3] = (uint8_t)(value >> 24);
+	return 4;
+}
+
+// Start a {"nodeType":..., "nodeID":..., "data": report, the caller writes the data value and ends the object
+static void beginNodeMessage(cJSON_Writer *writer, const char *nodeType, int nodeID) {
+	cJSON_WriterInit(writer, Usart_sink, NULL);
+	cJSON_WriterBeginObject(writer);
+	cJSON_WriterKey(writer, "nodeType");
+	cJSON_WriterString(writer, nodeType);
+	cJSON_WriterKey(writer, "nodeID");
+	cJSON_WriterInt(writer, nodeID);
+	cJSON_WriterKey(writer, "data");
+}
+
+// Send a report with a text payload (NUL terminated, dataLength bytes), the USART is held for the whole message
+void sendNodeMessage(const char *nodeType, int nodeID, const char *data, uint16_t dataLength) {
+	cJSON_Writer writer;
+
+	if (xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+		if (linkMode == LINK_BINARY) {
+			// Node ID and the text, cut to what fits into a frame
+			uint8_t payload[COBS_FRAME_MAX_PAYLOAD];
+			uint16_t length = dataLength;
+
+			if (length > sizeof(payload) - 1) {
+				length = sizeof(payload) - 1;
+			}
+			payload[0] = (uint8_t)nodeID;
+			memcpy(&payload[1], data, length);
+			writeBinaryFrame(binaryFrameType(FRAME_TEXT, nodeType), payload, length + 1);
+		} else {
+			beginNodeMessage(&writer, nodeType, nodeID);
+			cJSON_WriterString(&writer, data);
+			cJSON_WriterEndObject(&writer);
+		}
+		xSemaphoreGive(xUartMutex);
+	}
+}
+
+// Send the receive error counters of the command link, the payload is an object:
+// {"nodeType":"SYS","nodeID":...,"data":{"ORE":...,"FE":...,"NE":...,"PE":...,"OVW":...,"LAT_CYC":...,"LATMAX_CYC":...}}
+// (a FRAME_COUNTERS frame with the counters in the same order in binary mode)
+void sendLinkStatus(int nodeID) {
+	cJSON_Writer writer;
+	USART_Stats_t stats;
+
+	MCAL_USART_Get_Stats(USART1, &stats);
+	if (xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+		if (linkMode == LINK_BINARY) {
+			uint8_t payload[1 + 7 * 4];
+			uint16_t length = 0;
+
+			payload[length++] = (uint8_t)nodeID;
+			length += putUint32(&payload[length], stats.Overrun);
+			length += putUint32(&payload[length], stats.Framing);
+			length += putUint32(&payload[length], stats.Noise);
+			length += putUint32(&payload[length], stats.Parity);
+			length += putUint32(&payload[length], rxOverwrites);
+			length += putUint32(&payload[length], actuationLatency);
+			length += putUint32(&payload[length], actuationLatencyMax);
+			writeBinaryFrame(binaryFrameType(FRAME_COUNTERS, "SYS"), payload, length);
+			xSemaphoreGive(xUartMutex);
+			return;
+		}
+		beginNodeMessage(&writer, "SYS", nodeID);
+		cJSON_WriterBeginObject(&writer);
+		cJSON_WriterKey(&writer, "ORE");
+		cJSON_WriterInt(&writer, (int)stats.Overrun);
+		cJSON_WriterKey(&writer, "FE");
+		cJSON_WriterInt(&writer, (int)stats.Framing);
+		cJSON_WriterKey(&writer, "NE");
+		cJSON_WriterInt(&writer, (int)stats.Noise);
+		cJSON_WriterKey(&writer, "PE");
+		cJSON_WriterInt(&writer, (int)stats.Parity);
+		cJSON_WriterKey(&writer, "OVW");
+		cJSON_WriterInt(&writer, (int)rxOverwrites);
+		cJSON_WriterKey(&writer, "LAT_CYC");
+		cJSON_WriterInt(&writer, (int)actuationLatency);
+		cJSON_WriterKey(&writer, "LATMAX_CYC");
+		cJSON_WriterInt(&writer, (int)actuationLatencyMax);
+		cJSON_WriterEndObject(&writer);
+		cJSON_WriterEndObject(&writer);
+		xSemaphoreGive(xUartMutex);
+	}
+}
+
+// Write the decimal digits of value into digits (11 bytes are enough for any int), returns their count
+static uint16_t formatInt(char *digits, int value) {
+	char reversed[11];
+	unsigned int magnitude = (value < 0) ? 0U - (unsigned int)value : (unsigned int)value;
+	uint16_t count = 0;
+	uint16_t length = 0;
+
+	do {
+		reversed[count++] = (char)('0' + (magnitude % 10));
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	if (value < 0) {
+		digits[length++] = '-';
+	}
+	while (count > 0) {
+		digits[length++] = reversed[--count];
+	}
+	return length;
+}
+
+// A segment of constant text, sent from flash as it is
+#define SEGMENT_TEXT(text) { (const uint8_t *)(text), sizeof(text) - 1 }
+
+// Send a report whose payload is a number followed by its unit (e.g. "25°C")
+// The message is six segments sent back to back by the TX DMA: the texts straight from flash and the two numbers
+// formatted into static buffers, so nothing is copied into the TX ring. The DMA only starts once the ring is empty
+// and MCAL_USART_Write waits while the DMA sends, so the reports still leave in the order they were sent.
+// A reading only holds a node type, digits and a unit, so unlike sendNodeMessage nothing needs escaping.
+// In binary mode it is a FRAME_READING frame instead.
+void sendNodeReading(const NodeConfig *config, int value) {
+	// Read by the DMA after this returns, only changed again once the previous reading has been sent
+	static char idDigits[11];
+	static char valueDigits[11];
+	static USART_Segment_t segments[] = {
+		{ NULL, 0 },
+		{ (const uint8_t *)idDigits, 0 },
+		SEGMENT_TEXT(",\"data\":\""),
+		{ (const uint8_t *)valueDigits, 0 },
+		{ NULL, 0 },
+		SEGMENT_TEXT("\"}")
+	};
+
+	if (xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+		if (linkMode == LINK_BINARY) {
+			// Node ID, the value as a number and the unit
+			uint8_t payload[COBS_FRAME_MAX_PAYLOAD];
+			uint16_t length = 0;
+			uint16_t unitLength = config->unitLength;
+
+			if (unitLength > sizeof(payload) - 5) {
+				unitLength = sizeof(payload) - 5;
+			}
+			payload[length++] = config->id;
+			length += putUint32(&payload[length], (uint32_t)value);
+			memcpy(&payload[length], config->unit, unitLength);
+			writeBinaryFrame(binaryFrameType(FRAME_READING, (config->type == NODE_TYPE_SENSOR) ? "NS" : "NA"), payload, length + unitLength);
+			xSemaphoreGive(xUartMutex);
+			return;
+		}
+
+		// Wait for the previous report, ring or DMA, before its digits are overwritten
+		while (MCAL_USART_TX_Busy(USART1)) {
+			vTaskDelay(1);
+		}
+		if (config->type == NODE_TYPE_SENSOR) {
+			segments[0] = (USART_Segment_t)SEGMENT_TEXT("{\"nodeType\":\"NS\",\"nodeID\":");
+		} else {
+			segments[0] = (USART_Segment_t)SEGMENT_TEXT("{\"nodeType\":\"NA\",\"nodeID\":");
+		}
+		segments[1].Length = formatInt(idDigits, config->id);
+		segments[3].Length = formatInt(valueDigits, value);
+		segments[4].Data = (const uint8_t *)config->unit;
+		segments[4].Length = config->unitLength;
+		MCAL_USART_WriteDMA(USART1, segments, sizeof(segments) / sizeof(segments[0]));
+		xSemaphoreGive(xUartMutex);
 	}
 }
 
 // UART Initialization function
 void UART_Init(USART_NUM_t uart_num) {
-	USART_Config_t UART_CNFG_s;
+	USART_Config_t UART_CNFG_s = {0};
 	UART_CNFG_s.Async_EN = USART_Enable;
-	UART_CNFG_s.Async_Config_s.Baud_Rate = 9600; // Set baud rate to 9600
+	UART_CNFG_s.Async_Config_s.Baud_Rate = UART_DEFAULT_BAUD_RATE;
 	UART_CNFG_s.Async_Config_s.Stop_Bits = Stop_1; // 1 stop bit
 	UART_CNFG_s.Async_Config_s.Word_Length = Eight_bits; // 8-bit word length
-	UART_CNFG_s.interrupts_CNFG.RX_Interrupt_Enable_Or_Disable = USART_Enable; // Enable RX interrupt
-	UART_CNFG_s.CallBack_FN = Usart_callback; // Set callback function for USART interrupts
+	UART_CNFG_s.Flow_Control = UART_FLOW_CONTROL;
+	UART_CNFG_s.RX_High_Water = UART_RX_HIGH_WATER;
+	UART_CNFG_s.RX_Low_Water = UART_RX_LOW_WATER;
 
-	// Initialize USART1 or USART2 depending on the selected USART
+	// Initialize USART1 or USART2 depending on the selected USART, received bytes are stored by DMA
 	if (uart_num == USART_1) {
 		MCAL_USART_Init(USART1, &UART_CNFG_s);
 		MCAL_USART_GPIO_Pins_Config(USART1); // Configure USART1 GPIO pins
+		MCAL_USART_Start_RX_DMA(USART1, rxDmaBuffer, sizeof(rxDmaBuffer), Usart_frame_callback);
+		MCAL_USART_Start_Auto_Baud(USART1, Usart_auto_baud_callback); // The rate of the gateway is taken from its first command
 	}
 	else if (uart_num == USART_2) {
 		MCAL_USART_Init(USART2, &UART_CNFG_s);
 		MCAL_USART_GPIO_Pins_Config(USART2); // Configure USART2 GPIO pins
+		MCAL_USART_Start_RX_DMA(USART2, rxDmaBuffer, sizeof(rxDmaBuffer), Usart_frame_callback);
+		MCAL_USART_Start_Auto_Baud(USART2, Usart_auto_baud_callback);
 	}
 }
 
@@ -201,293 +511,452 @@ void RELAY_DeInit(RELAY_GPIO_PORT_t port, char pin_num_signal) {
 	}
 }
 
-// Sensor Task for reading temperature and light sensor data
-void sensorTask(void *pvParameters) {
-	while (1) {
-		// Wait for the semaphore indicating that the sensor is enabled
-		if (xSemaphoreTake(tempSensorSemaphore, portMAX_DELAY) == pdTRUE) {
-			// Perform temperature sensor reading
-			if (adc_check(ADC1)) {
-				int data = 0;
-				float temperature = 0.0f;
-				const float Vref_measured = 3.27f; // Measured Vref for ADC
-				const float offset = -10.0f; // Calibration offset for temperature
-				data = adc_rx(ADC1, PA, 0); // Read ADC value from temperature sensor
-
-				// Convert ADC value to voltage
-				float voltage = (float)data * Vref_measured / 4095.0f;
-
-				// Convert voltage to temperature
-				temperature = (voltage / 0.01f) + offset;
-				analog_rx_temperature = (int)temperature;
-
-				// Send the temperature data as a JSON message over UART
-				if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-					char jsonString[100];
-					snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"%d°C\"}", TEMP_SENSOR_NODE_ID, analog_rx_temperature);
-
-					// Send the JSON string byte by byte over USART
-					for (int i = 0; i < strlen(jsonString); i++) {
-						MCAL_USART_SendChar(USART1, jsonString[i]);
-					}
+// ADC of a sensor node
+static ADC_REGISTERS_t *nodeAdc(const NodeConfig *config) {
+	return (config->device == 2) ? ADC2 : ADC1;
+}
 
-					xSemaphoreGive(USARTSemaphore); // Release the USART semaphore
-				}
-			}
-			vTaskDelay(tempSensorDuration * 1000); // Delay for the next reading
-			xSemaphoreGive(tempSensorSemaphore); // Release the semaphore after the task is complete
+// GPIO port of an actuator node
+static GPIO_REGISTERS_t *nodeGpio(const NodeConfig *config) {
+	if (config->port == PORTA) {
+		return GPIOA;
+	}
+	if (config->port == PORTB) {
+		return GPIOB;
+	}
+	return GPIOC;
+}
+
+// Sensor driver: power the ADC input of the node
+void adcSensorEnable(const NodeConfig *config) {
+	adc_init(nodeAdc(config), config->port, config->pin);
+}
+
+void adcSensorDisable(const NodeConfig *config) {
+	adc_Deinit(nodeAdc(config), config->port, config->pin);
+}
+
+// Sensor driver: raw ADC value (0 to 4095)
+uint8_t adcSensorRead(const NodeConfig *config, int *value) {
+	if (!adc_check(nodeAdc(config))) {
+		return 0;
+	}
+	*value = adc_rx(nodeAdc(config), config->port, config->pin);
+	return 1;
+}
+
+// Sensor driver: LM35 temperature in °C
+uint8_t lm35SensorRead(const NodeConfig *config, int *value) {
+	const float Vref_measured = 3.27f; // Measured Vref for ADC
+	const float offset = -10.0f; // Calibration offset for temperature
+	int data = 0;
+
+	if (!adcSensorRead(config, &data)) {
+		return 0;
+	}
+
+	// Convert ADC value to voltage, then to temperature (10 mV per °C)
+	float voltage = (float)data * Vref_measured / 4095.0f;
+	*value = (int)((voltage / 0.01f) + offset);
+	return 1;
+}
+
+// Actuator driver: open drain output on the pin of the node
+void gpioActuatorEnable(const NodeConfig *config) {
+	RELAY_Init((RELAY_GPIO_PORT_t)config->port, config->pin);
+}
+
+void gpioActuatorDisable(const NodeConfig *config) {
+	RELAY_DeInit((RELAY_GPIO_PORT_t)config->port, config->pin);
+}
+
+// Actuator driver: the relay is on while the pin is low
+void gpioActuatorWrite(const NodeConfig *config, int value) {
+	MCAL_GPIO_WritePin(nodeGpio(config), config->pin, value ? 0 : 1);
+}
+
+// Power the nodes of one type up or down as ENA and DIS asked, runs in the task that drives them
+static void powerNodes(NodeType type) {
+	for (uint8_t slot = 0; slot < nodeRegistryCount(); slot++) {
+		const NodeConfig *config = nodeConfig(slot);
+		NodeState *state = nodeState(slot);
+
+		if (config->type != type) {
+			continue;
+		}
+		if (state->powered && !state->poweredOn) {
+			config->ops->enable(config);
+			state->poweredOn = 1;
+		} else if (!state->powered && state->poweredOn) {
+			config->ops->disable(config);
+			state->poweredOn = 0;
 		}
 	}
 }
-// Light Sensor Task
-void lightsensorTask(void *pvParameters) {
-    // Infinite loop to continuously monitor light sensor status
-    while (1) {
-        // Wait for the sensor to be enabled (sensorEnabled flag is set)
-        if (xSemaphoreTake(lightSensorSemaphore, portMAX_DELAY) == pdTRUE) {
-            // Perform sensor reading if enabled
-            if(adc_check(ADC2)) {
-                // Read light sensor data from ADC2
-                analog_rx_light = adc_rx(ADC2, PA, 1);
-
-                // Check if USART semaphore is available for communication
-                if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                    // Prepare a JSON string to send light sensor data
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"%d\"}", LIGHT_SENSOR_NODE_ID, analog_rx_light);
-
-                    // Send the JSON string character by character via USART
-                    for (int i = 0; i < strlen(jsonString); i++) {
-                        MCAL_USART_SendChar(USART1, jsonString[i]);
-                    }
-
-                    // Release USART semaphore after transmission
-                    xSemaphoreGive(USARTSemaphore);
-                }
-            }
-            // Delay for the light sensor reading interval (in seconds)
-            vTaskDelay(lightSensorDuration * 1000);
-            // Release light sensor semaphore
-            xSemaphoreGive(lightSensorSemaphore);
-        }
-    }
-}
-
-// UART Task to handle receiving and processing commands
-void uartTask(void *pvParameters) {
-    JsonMessage jsonMsg;
-
-    // Infinite loop to continuously receive commands from UART
-    while (1) {
-        // Wait for a message in the queue
-        if (xQueueReceive(xJsonQueue, &jsonMsg, portMAX_DELAY) == pdTRUE) {
-            // Command handling for enabling sensors or actuators
-            if (strcmp(jsonMsg.command, "ENA") == 0) {
-                // Enable temperature sensor if node ID matches
-                if(jsonMsg.nodeID == TEMP_SENSOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // Initialize ADC for temperature sensor
-                    adc_init(ADC1, PA, 0);
-                }
-                // Enable light sensor if node ID matches
-                else if(jsonMsg.nodeID == LIGHT_SENSOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // Initialize ADC for light sensor
-                    adc_init(ADC2, PA, 1);
-                }
-                // Enable relay actuator if node ID matches
-                else if(jsonMsg.nodeID == RELAY_ACTUATOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NA\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // Initialize relay actuator
-                    RELAY_Init(PORTB, 5);
-                    relayStatus = relayLastStatus;
-                    xSemaphoreGive(relaySemaphore);
-                }
-            }
-            // Command handling for disabling sensors or actuators
-            else if (strcmp(jsonMsg.command, "DIS") == 0) {
-                // Disable temperature sensor if node ID matches
-                if(jsonMsg.nodeID == TEMP_SENSOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // De-initialize ADC for temperature sensor
-                    if (xSemaphoreTake(tempSensorSemaphore, portMAX_DELAY) == pdTRUE) {
-                        adc_Deinit(ADC1, PA, 0);
-                    }
-                }
-                // Disable light sensor if node ID matches
-                else if(jsonMsg.nodeID == LIGHT_SENSOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NS\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // De-initialize ADC for light sensor
-                    if (xSemaphoreTake(lightSensorSemaphore, portMAX_DELAY) == pdTRUE) {
-                        adc_Deinit(ADC2, PA, 1);
-                    }
-                }
-                // Disable relay actuator if node ID matches
-                else if(jsonMsg.nodeID == RELAY_ACTUATOR_NODE_ID) {
-                    // Prepare and send "DONE" message in JSON format
-                    char jsonString[100];
-                    snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NA\", \"nodeID\": %d, \"data\": \"DONE\"}", jsonMsg.nodeID);
-                    if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                        // Send JSON string over USART
-                        for (int i = 0; i < strlen(jsonString); i++) {
-                            MCAL_USART_SendChar(USART1, jsonString[i]);
-                        }
-                        xSemaphoreGive(USARTSemaphore);
-                    }
-                    // De-initialize relay actuator
-                    if (xSemaphoreTake(relaySemaphore, portMAX_DELAY) == pdTRUE) {
-                        relayLastStatus = relayStatus;
-                        RELAY_DeInit(PORTB, 5);
-                    }
-                }
-            }
-            // Command handling for activating or deactivating relays
-            else if (strcmp(jsonMsg.command, "ACT") == 0) {
-                if (strcmp(jsonMsg.data, "1") == 0) {
-                    relayStatus = 1; // Activate relay
-                }
-                if (strcmp(jsonMsg.data, "0") == 0) {
-                    relayStatus = 0; // Deactivate relay
-                }
-            }
-            // Command handling for status reporting
-            else if (strcmp(jsonMsg.command, "STA") == 0) {
-                // Prepare JSON response with relay status
-                char jsonString[100];
-                snprintf(jsonString, sizeof(jsonString), "{\"nodeType\":\"NA\", \"nodeID\": %d, \"data\": \"%d\"}", jsonMsg.nodeID, relayStatus);
-                if (xSemaphoreTake(USARTSemaphore, portMAX_DELAY) == pdTRUE) {
-                    // Send status information via USART
-                    for (int i = 0; i < strlen(jsonString); i++) {
-                        MCAL_USART_SendChar(USART1, jsonString[i]);
-                    }
-                    xSemaphoreGive(USARTSemaphore);
-                }
-            }
-            // Command handling for setting durations
-            else if (strcmp(jsonMsg.command, "DUR") == 0) {
-                if(jsonMsg.nodeID == TEMP_SENSOR_NODE_ID) {
-                    tempSensorDuration = atoi(jsonMsg.data);  // Set temperature sensor duration in seconds
-                    xSemaphoreGive(tempSensorSemaphore);
-                } else if(jsonMsg.nodeID == LIGHT_SENSOR_NODE_ID) {
-                    lightSensorDuration = atoi(jsonMsg.data);  // Set light sensor duration in seconds
-                    xSemaphoreGive(lightSensorSemaphore);
-                }
-            }
-        }
-    }
-}
-
-
-// Relay Control Task
-void relayTask(void *pvParameters) {
 
+// Put the active sensors into the deadline heap again after a command changed them.
+// A sensor that has just been started is due at once, the others keep their next reading.
+static void scheduleSensors(DeadlineHeap *heap) {
+	TickType_t now = xTaskGetTickCount();
+
+	deadlineHeapInit(heap);
+	for (uint8_t slot = 0; slot < nodeRegistryCount(); slot++) {
+		NodeState *state = nodeState(slot);
+
+		if (nodeConfig(slot)->type != NODE_TYPE_SENSOR || !state->active) {
+			state->scheduled = 0;
+			continue;
+		}
+		if (!state->scheduled) {
+			state->nextDue = now;
+			state->scheduled = 1;
+		}
+		deadlineHeapPush(heap, slot, state->nextDue);
+	}
+}
+
+// Sampler Task reading every active sensor node when its reading is due.
+// The readings are kept on a fixed grid of due times (like vTaskDelayUntil), so the time spent reading and sending
+// does not add up, and one task and one heap of NODE_MAX entries serve any number of sensors.
+// The commands only change the NodeState and notify the task, it is the only one powering and reading the sensors.
+void samplerTask(void *pvParameters) {
+	DeadlineHeap heap;
+
+	deadlineHeapInit(&heap);
 	while (1) {
-		// Wait for the relay semaphore to ensure exclusive access to relay control
-		if (xSemaphoreTake(relaySemaphore, portMAX_DELAY) == pdTRUE)
-		{
+		const Deadline *next = deadlineHeapTop(&heap);
+		TickType_t wait = portMAX_DELAY;
+		TickType_t now = xTaskGetTickCount();
+		uint8_t slot;
+		NodeState *state;
+
+		// Sleep until the earliest reading is due, or until a command changes the sensors
+		if (next != NULL) {
+			wait = DEADLINE_BEFORE(now, next->due) ? (TickType_t)(next->due - now) : 0;
+		}
+		if (wait > 0) {
+			uint32_t events = 0;
 
-			// Check relay status and turn the relay on or off accordingly
-			if (relayStatus == 1) {
-				MCAL_GPIO_WritePin(GPIOB, 5, 0);  // Turn relay on
-			} else {
-				MCAL_GPIO_WritePin(GPIOB, 5, 1);  // Turn relay off
+			if (xTaskNotifyWait(0, NOTIFY_NODE_EVENTS, &events, wait) == pdTRUE) {
+				if (events & (NOTIFY_NODE_ENABLE | NOTIFY_NODE_DISABLE)) {
+					powerNodes(NODE_TYPE_SENSOR);
+				}
+				scheduleSensors(&heap);
 			}
+			continue;
+		}
 
-			// Release the relay semaphore after completing the operation
-			xSemaphoreGive(relaySemaphore);
+		slot = next->slot;
+		state = nodeState(slot);
+		deadlineHeapPop(&heap);
 
-			// Delay for 100 ms before checking relay status again
-			vTaskDelay(100);  // Check relay status every 100 ms
+		// Read the sensor unless a DIS stopped it since the heap was built
+		if (state->active && state->poweredOn) {
+			const NodeConfig *config = nodeConfig(slot);
+			int value = 0;
+
+			if (config->ops->read(config, &value)) {
+				state->value = value;
+				sendNodeReading(config, value);
+			}
+		}
+
+		// Next reading one period after the one that was due, or one period from now if the sampler fell behind
+		state->nextDue += (TickType_t)state->period * configTICK_RATE_HZ;
+		now = xTaskGetTickCount();
+		if (!DEADLINE_BEFORE(now, state->nextDue)) {
+			state->nextDue = now + (TickType_t)state->period * configTICK_RATE_HZ;
 		}
+		deadlineHeapPush(&heap, slot, state->nextDue);
 	}
 }
 
-// Data Processing Task
-void JsonProcessingTask(void *pvParameters) {
+// Drop the command being decoded and the commands waiting in xJsonQueue, decoding resumes at the next '{'
+// (at the next frame in binary mode)
+static void resetJsonDecoder(void) {
+	JsonMessage jsonMsg;
+
+	cJSON_PushReset(&jsonPushParser);
+	memset(&rxJsonMsg, 0, sizeof(rxJsonMsg));
+	cJSON_PushRecordReset(&rxJsonRecord);
+	cobsDecoderInit(&rxCobsDecoder);
+	while (xQueueReceive(xJsonQueue, &jsonMsg, 0) == pdTRUE) {
+	}
+}
+
+// Switch the framing of the commands and reports, the reports already sent keep their framing
+void setLinkMode(uint8_t mode) {
+	if (xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+		linkMode = mode;
+		rxFrameErrors = 0;
+		xSemaphoreGive(xUartMutex);
+	}
+}
 
+// Turn a binary command frame into a JsonMessage, so that both framings are handled by dispatchCommand.
+// The type byte is the command code + 1, the payload is the node ID (one byte) followed by the data text.
+static uint8_t decodeBinaryCommand(const CobsDecoder *decoder, JsonMessage *jsonMsg) {
+	uint8_t type = cobsFrameType(decoder);
+	uint16_t length = cobsFramePayloadLength(decoder);
+
+	// Known command, a node ID and data that leaves room for the terminating NUL
+	if (type == 0 || type > CMD_COUNT || length < 1 || length > sizeof(jsonMsg->data)) {
+		return 0;
+	}
+	memset(jsonMsg, 0, sizeof(JsonMessage));
+	jsonMsg->commandCode = type - 1;
+	strcpy(jsonMsg->command, commandNames[type - 1]);
+	jsonMsg->nodeID = cobsFramePayload(decoder)[0];
+	memcpy(jsonMsg->data, cobsFramePayload(decoder) + 1, length - 1);
+	return 1;
+}
+
+// Decode one byte in binary mode (at position in the received byte stream), a complete command is queued like a JSON one
+static void pushBinaryByte(uint8_t byte, uint32_t position) {
+	JsonMessage jsonMsg;
+
+	switch (cobsDecoderPush(&rxCobsDecoder, byte)) {
+	case COBS_FRAME_OK:
+		if (decodeBinaryCommand(&rxCobsDecoder, &jsonMsg)) {
+			jsonMsg.frameEndCycles = rxReceivedCycles(position);
+			xQueueSend(xJsonQueue, &jsonMsg, 0);
+		}
+		rxFrameErrors = 0;
+		break;
+	case COBS_FRAME_ERROR:
+		// The gateway is not (or no longer) sending frames, go back to JSON, which resumes at the next '{'
+		if (++rxFrameErrors >= LINK_MAX_FRAME_ERRORS) {
+			setLinkMode(LINK_JSON);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+// UART Task to decode the received bytes and process the commands
+void uartTask(void *pvParameters) {
 	JsonMessage jsonMsg;
+	uint32_t streamTail = 0; // End of the decoded bytes in the received byte stream
+	uint32_t written;        // Bytes the receive DMA has written, reported or not
 
+	// Infinite loop to continuously receive commands from UART
 	while (1) {
-		// Wait for the JSON semaphore to signal that a new JSON message is available
-		if (xSemaphoreTake(xJsonSemaphore, portMAX_DELAY) == pdTRUE) {
+		// Wait until the USART receive DMA reports new bytes
+		xTaskNotifyWait(0, NOTIFY_FRAME_READY, NULL, portMAX_DELAY);
 
-			// Parse the JSON buffer to extract command data
-			cJSON *json = cJSON_Parse(jsonBuffer);
+		// Decode up to the last reported byte, in pieces that end at the end of rxDmaBuffer
+		while (streamTail != rxStreamHead) {
+			uint32_t start = streamTail;
+			uint16_t offset = start % RX_DMA_BUFFER_SIZE;
+			uint16_t length = RX_DMA_BUFFER_SIZE - offset;
 
-			// Extract "command" from JSON and copy it into jsonMsg
-			cJSON *command = cJSON_GetObjectItemCaseSensitive(json, "command");
-			if (cJSON_IsString(command) && (command->valuestring != NULL)) {
-				strncpy(jsonMsg.command, command->valuestring, sizeof(jsonMsg.command) - 1);
-				jsonMsg.command[sizeof(jsonMsg.command) - 1] = '\0';  // Ensure null termination
+			if (rxStreamHead - start < length) {
+				length = rxStreamHead - start;
 			}
+			streamTail = start + length;
 
-			// Extract "nodeID" from JSON and store it in jsonMsg
-			cJSON *nodeID = cJSON_GetObjectItemCaseSensitive(json, "nodeID");
-			if (cJSON_IsNumber(nodeID)) {
-				jsonMsg.nodeID = nodeID->valueint;
+			// The '{' of this command was measured instead of received, give it back to the tokenizer
+			if (autoBaudPending) {
+				autoBaudPending = 0;
+				resetJsonDecoder();
+				cJSON_PushByte(&jsonPushParser, '{');
 			}
 
-			// Extract "data" from JSON and copy it into jsonMsg
-			cJSON *data = cJSON_GetObjectItemCaseSensitive(json, "data");
-			if (cJSON_IsString(data) && (data->valuestring != NULL)) {
-				strncpy(jsonMsg.data, data->valuestring, sizeof(jsonMsg.data) - 1);
-				jsonMsg.data[sizeof(jsonMsg.data) - 1] = '\0';  // Ensure null termination
+			// Feed the bytes to the tokenizer (or the frame decoder), complete commands are queued by JsonPush_callback
+			if (linkMode == LINK_BINARY) {
+				for (uint16_t i = 0; i < length; i++) {
+					pushBinaryByte(rxDmaBuffer[offset + i], start + i);
+				}
+			} else {
+				rxDecodePosition = start;
+				cJSON_PushBytes(&jsonPushParser, &rxDmaBuffer[offset], length);
 			}
+			MCAL_USART_RX_Release(USART1, length);
 
-			// Enqueue the parsed message for further processing
-			xQueueSend(xJsonQueue, &jsonMsg, 0);
+			// The byte at stream position start is overwritten once the DMA has written more than a buffer past it.
+			// Read after decoding, the DMA position tells exactly whether these bytes were still intact
+			written = MCAL_USART_RX_Written(USART1);
+			if ((int32_t)(written - start - RX_DMA_BUFFER_SIZE) > 0) {
+				rxOverwrites++;
+				resetJsonDecoder();
+
+				// Commands completed by these bytes may hold overwritten ones, they are dropped with the one being decoded
+				xQueueReset(xJsonQueue);
+
+				// Skip the reported bytes the DMA has written over by now, decoding resumes at the next command
+				if ((int32_t)(written - RX_DMA_BUFFER_SIZE - streamTail) > 0) {
+					uint32_t skipped = written - RX_DMA_BUFFER_SIZE - streamTail;
+
+					if (skipped > rxStreamHead - streamTail) {
+						skipped = rxStreamHead - streamTail;
+					}
+					MCAL_USART_RX_Release(USART1, (uint16_t)skipped);
+					streamTail += skipped;
+				}
+				continue;
+			}
 
-			// Clean up by freeing the allocated JSON object
-			cJSON_Delete(json);
+			// Handle the commands completed by these bytes
+			while (xQueueReceive(xJsonQueue, &jsonMsg, 0) == pdTRUE) {
+				dispatchCommand(&jsonMsg);
+			}
 		}
 	}
 }
 
+// Wake the task driving the node, which applies the change the command made to its NodeState
+static void notifyNodeTask(uint8_t slot, uint32_t events) {
+	TaskHandle_t task = (nodeConfig(slot)->type == NODE_TYPE_SENSOR) ? xSamplerTaskHandle : xActuatorTaskHandle;
+
+	xTaskNotify(task, events, eSetBits);
+}
+
+// Command handlers, called by dispatchCommand (a "DONE" reply listed in commandTable is sent before them)
+
+// ENA: power the sensor, its readings start with the next DUR
+void enableSensor(const JsonMessage *jsonMsg, uint8_t slot) {
+	nodeState(slot)->powered = 1;
+	notifyNodeTask(slot, NOTIFY_NODE_ENABLE);
+}
+
+// ENA: drive the actuator again, with the state it had when it was disabled
+void enableActuator(const JsonMessage *jsonMsg, uint8_t slot) {
+	NodeState *state = nodeState(slot);
+
+	state->value = state->savedValue;
+	state->powered = 1;
+	notifyNodeTask(slot, NOTIFY_NODE_ENABLE);
+}
+
+// DIS: stop the readings of the sensor and power it down, the sampler does so between two readings
+void disableSensor(const JsonMessage *jsonMsg, uint8_t slot) {
+	nodeState(slot)->active = 0;
+	nodeState(slot)->powered = 0;
+	notifyNodeTask(slot, NOTIFY_NODE_DISABLE);
+}
 
+// DIS: release the actuator pin and remember its state
+void disableActuator(const JsonMessage *jsonMsg, uint8_t slot) {
+	NodeState *state = nodeState(slot);
 
+	state->savedValue = state->value;
+	state->powered = 0;
+	notifyNodeTask(slot, NOTIFY_NODE_DISABLE);
+}
 
+// ACT: switch the actuator on ("1") or off ("0")
+void setActuator(const JsonMessage *jsonMsg, uint8_t slot) {
+	if (strcmp(jsonMsg->data, "1") == 0) {
+		nodeState(slot)->value = 1; // Activate relay
+	}
+	if (strcmp(jsonMsg->data, "0") == 0) {
+		nodeState(slot)->value = 0; // Deactivate relay
+	}
+	actuationStartCycles = jsonMsg->frameEndCycles;
+	actuationPending = 1;
+	notifyNodeTask(slot, NOTIFY_OUTPUT_CHANGED);
+}
+
+// STA: report the output of an actuator or the last reading of a sensor
+void reportNodeStatus(const JsonMessage *jsonMsg, uint8_t slot) {
+	sendNodeReading(nodeConfig(slot), nodeState(slot)->value);
+}
+
+// DUR: seconds between readings (1 to 65535), also starts the readings.
+// A sensor that is already active takes the new period after its next reading
+void setSensorPeriod(const JsonMessage *jsonMsg, uint8_t slot) {
+	int period = atoi(jsonMsg->data);
+
+	nodeState(slot)->period = (period < 1) ? 1 : (period > 0xFFFF) ? 0xFFFF : period;
+	nodeState(slot)->active = 1;
+	notifyNodeTask(slot, NOTIFY_PERIOD_CHANGED);
+}
+
+// BAU: change the baud rate of the command link
+void setBaudRate(const JsonMessage *jsonMsg, uint8_t slot) {
+	uint32_t baudRate = strtoul(jsonMsg->data, NULL, 10);
+	uint32_t errorPPM = 0;
+
+	// The reply is sent at the current rate, the gateway switches once it has it
+	if (MCAL_USART_Calculate_BRR(RCC_Get_PCLK2(), baudRate, &errorPPM) == 0 || errorPPM > USART_BAUD_MAX_ERROR_PPM) {
+		sendNodeMessage("SYS", jsonMsg->nodeID, NODE_TEXT("ERROR"));
+	} else {
+		sendNodeMessage("SYS", jsonMsg->nodeID, NODE_TEXT("DONE"));
+		// Wait for the reply to be handed to the USART and for its last frame to leave the shift register
+		while (MCAL_USART_TX_Busy(USART1)) {
+			vTaskDelay(1);
+		}
+		vTaskDelay(2);
+		MCAL_USART_Set_Baud_Rate(USART1, baudRate);
+	}
+}
+
+// LNK: report the error counters of the command link and the actuation latency
+void reportLinkStatus(const JsonMessage *jsonMsg, uint8_t slot) {
+	sendLinkStatus(jsonMsg->nodeID);
+}
+
+// ABD: detect the baud rate again from the next command
+void detectBaudRate(const JsonMessage *jsonMsg, uint8_t slot) {
+	while (MCAL_USART_TX_Busy(USART1)) {
+		vTaskDelay(1);
+	}
+	vTaskDelay(2);
+	// The rate is measured on a '{', so the gateway has to use JSON again
+	setLinkMode(LINK_JSON);
+	MCAL_USART_Start_Auto_Baud(USART1, Usart_auto_baud_callback);
+}
+
+// BIN: binary framing handshake, the reply still uses the current framing
+void selectBinaryFraming(const JsonMessage *jsonMsg, uint8_t slot) {
+	if (strcmp(jsonMsg->data, LINK_MAGIC) == 0) {
+		sendNodeMessage("SYS", jsonMsg->nodeID, NODE_TEXT(LINK_MAGIC));
+		setLinkMode(LINK_BINARY);
+	} else {
+		sendNodeMessage("SYS", jsonMsg->nodeID, NODE_TEXT("ERROR"));
+	}
+}
+
+// JSN: go back to JSON
+void selectJsonFraming(const JsonMessage *jsonMsg, uint8_t slot) {
+	setLinkMode(LINK_JSON);
+}
+
+
+// Actuator Control Task, the only one driving the actuator pins
+void actuatorTask(void *pvParameters) {
+
+	while (1) {
+		// Sleep until ENA, DIS or ACT changes an actuator
+		xTaskNotifyWait(0, NOTIFY_NODE_EVENTS, NULL, portMAX_DELAY);
+		powerNodes(NODE_TYPE_ACTUATOR);
+
+		// Drive the enabled actuators whose output changed, a disabled one is written again once it is enabled
+		for (uint8_t slot = 0; slot < nodeRegistryCount(); slot++) {
+			const NodeConfig *config = nodeConfig(slot);
+			NodeState *state = nodeState(slot);
+			uint8_t output = state->value ? 1 : 0;
+
+			if (config->type != NODE_TYPE_ACTUATOR) {
+				continue;
+			}
+			if (!state->poweredOn) {
+				state->output = NODE_OUTPUT_UNKNOWN;
+			} else if (state->output != output) {
+				config->ops->write(config, output);
+				state->output = output;
+
+				// Time from the end of the ACT frame to the pin write
+				if (actuationPending) {
+					actuationPending = 0;
+					actuationLatency = DWT->DWT_CYCCNT - actuationStartCycles;
+					if (actuationLatency > actuationLatencyMax) {
+						actuationLatencyMax = actuationLatency;
+					}
+				}
+			}
+		}
+		actuationPending = 0;
+	}
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Node registry, see node_registry.h
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+#include "node_registry.h"
+
+_Static_assert(sizeof(NodeState) <= NODE_STATE_MAX_BYTES, "NodeState is over its RAM budget (NODE_STATE_MAX_BYTES)");
+_Static_assert((NODE_INDEX_SIZE & (NODE_INDEX_SIZE - 1)) == 0 && NODE_INDEX_SIZE >= 2 * NODE_MAX, "NODE_INDEX_SIZE must be a power of two of at least 2 * NODE_MAX");
+
+static const NodeConfig *registryConfigs; // Table of the application
+static NodeState *registryStates;         // One per config
+static uint8_t registryCount;
+static uint8_t nodeIndex[NODE_INDEX_SIZE]; // Slot + 1 of the node IDs, 0 for a free entry, .bss.nodeIndex in the .map file
+
+// First index entry of a node ID, collisions go on to the next entries
+static uint8_t nodeHash(uint8_t nodeID) {
+	return (uint8_t)(nodeID ^ (nodeID >> 5)) & (NODE_INDEX_SIZE - 1);
+}
+
+// Register the nodes of configs and set their states to the reset values, returns the number registered.
+// Registration stops at NODE_MAX nodes or at a repeated ID, since the slots of the registered nodes must be
+// 0 to nodeRegistryCount() - 1: a caller that gets less than count has a bad table
+uint8_t nodeRegistryInit(const NodeConfig *configs, NodeState *states, uint8_t count) {
+	registryConfigs = configs;
+	registryStates = states;
+	registryCount = 0;
+	for (uint8_t i = 0; i < NODE_INDEX_SIZE; i++) {
+		nodeIndex[i] = 0;
+	}
+
+	for (uint8_t slot = 0; slot < count && slot < NODE_MAX; slot++) {
+		uint8_t entry = nodeHash(configs[slot].id);
+
+		if (nodeFind(configs[slot].id) != NODE_NOT_FOUND) {
+			break;
+		}
+		while (nodeIndex[entry] != 0) {
+			entry = (entry + 1) & (NODE_INDEX_SIZE - 1);
+		}
+		nodeIndex[entry] = slot + 1;
+
+		states[slot].value = 0;
+		states[slot].savedValue = 0;
+		states[slot].nextDue = 0;
+		states[slot].period = configs[slot].period;
+		states[slot].active = 0;
+		states[slot].scheduled = 0;
+		states[slot].powered = 0;
+		states[slot].poweredOn = 0;
+		states[slot].output = NODE_OUTPUT_UNKNOWN;
+		registryCount++;
+	}
+	return registryCount;
+}
+
+// Number of registered nodes
+uint8_t nodeRegistryCount(void) {
+	return registryCount;
+}
+
+// Slot of a node ID, NODE_NOT_FOUND if it is not registered
+uint8_t nodeFind(int nodeID) {
+	uint8_t entry;
+
+	if (nodeID < 0 || nodeID > 0xFF) {
+		return NODE_NOT_FOUND;
+	}
+
+	// The index is at most half full, so a free entry ends the search after a few steps
+	for (entry = nodeHash((uint8_t)nodeID); nodeIndex[entry] != 0; entry = (entry + 1) & (NODE_INDEX_SIZE - 1)) {
+		if (registryConfigs[nodeIndex[entry] - 1].id == nodeID) {
+			return nodeIndex[entry] - 1;
+		}
+	}
+	return NODE_NOT_FOUND;
+}
+
+// Type of the node with this ID, NODE_TYPE_NONE if it is not registered
+NodeType nodeTypeOf(int nodeID) {
+	uint8_t slot = nodeFind(nodeID);
+
+	return (slot == NODE_NOT_FOUND) ? NODE_TYPE_NONE : (NodeType)registryConfigs[slot].type;
+}
+
+const NodeConfig *nodeConfig(uint8_t slot) {
+	return &registryConfigs[slot];
+}
+
+NodeState *nodeState(uint8_t slot) {
+	return &registryStates[slot];
+}
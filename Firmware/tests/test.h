@@ -0,0 +1,56 @@
+/*
+ * test.h
+ *
+ * Minimal check macros for the host tests, every test is its own executable
+ * and returns non zero when one of its checks failed.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+#include <string.h>
+
+static int testChecks;
+static int testFailures;
+
+#define CHECK(cond)																\
+	do {																		\
+		testChecks++;															\
+		if (!(cond)) {															\
+			testFailures++;														\
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);	\
+		}																		\
+	} while (0)
+
+#define CHECK_EQ(a, b)															\
+	do {																		\
+		long long testA_ = (long long)(a), testB_ = (long long)(b);			\
+		testChecks++;															\
+		if (testA_ != testB_) {													\
+			testFailures++;														\
+			fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",		\
+					__FILE__, __LINE__, #a, #b, testA_, testB_);				\
+		}																		\
+	} while (0)
+
+#define CHECK_STR(a, b)															\
+	do {																		\
+		const char *testA_ = (a), *testB_ = (b);								\
+		testChecks++;															\
+		if ((testA_ == NULL) || (testB_ == NULL) || (strcmp(testA_, testB_) != 0)) {	\
+			testFailures++;														\
+			fprintf(stderr, "%s:%d: CHECK_STR(%s, %s) failed: \"%s\" != \"%s\"\n",	\
+					__FILE__, __LINE__, #a, #b,									\
+					testA_ ? testA_ : "(null)", testB_ ? testB_ : "(null)");	\
+		}																		\
+	} while (0)
+
+// Print the summary line and return the exit code of the test
+static inline int testReport(const char *name)
+{
+	printf("%-24s %s (%d checks, %d failed)\n", name, testFailures ? "FAIL" : "ok", testChecks, testFailures);
+	return testFailures ? 1 : 0;
+}
+
+#endif /* TEST_H_ */
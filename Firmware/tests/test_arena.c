@@ -0,0 +1,104 @@
+/*
+ * test_arena.c
+ *
+ * cJSON parse sessions that allocate from a caller supplied arena (CJSON_ARENA).
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+static size_t heapAllocations;
+
+static void *countingMalloc(size_t size)
+{
+	heapAllocations++;
+	return malloc(size);
+}
+
+static const char command[] = "{\"command\":\"SET\",\"nodeID\":130,\"data\":\"ON\",\"value\":2.5,\"list\":[1,2,{\"a\":null}]}";
+
+// Nodes and their doubles are aligned whatever the alignment of the caller's buffer
+static void testAlignment(void)
+{
+	static double storage[512];
+	size_t shift;
+
+	for (shift = 0; shift < sizeof(double); shift++) {
+		cJSON_Arena arena;
+		cJSON *root, *item;
+
+		cJSON_InitArena(&arena, (unsigned char *)storage + shift, sizeof(storage) - sizeof(double));
+		root = cJSON_ParseWithArena(command, sizeof(command), NULL, 1, &arena);
+		CHECK(root != NULL);
+		if (root == NULL)
+			continue;
+
+		CHECK_EQ((uintptr_t)root % sizeof(double), 0);
+		cJSON_ArrayForEach(item, root) {
+			CHECK_EQ((uintptr_t)item % sizeof(double), 0);
+			CHECK_EQ((uintptr_t)&item->valuedouble % sizeof(double), 0);
+		}
+		CHECK_STR(cJSON_GetObjectItemCaseSensitive(root, "command")->valuestring, "SET");
+		CHECK_EQ(cJSON_GetObjectItemCaseSensitive(root, "nodeID")->valueint, 130);
+		CHECK(cJSON_GetObjectItemCaseSensitive(root, "value")->valuedouble == 2.5);
+		CHECK(cJSON_IsNull(cJSON_GetObjectItemCaseSensitive(cJSON_GetArrayItem(cJSON_GetObjectItemCaseSensitive(root, "list"), 2), "a")));
+	}
+}
+
+// A parse never touches the heap hooks, and reset gives all of it back
+static void testNoHeap(void)
+{
+	static double storage[256];
+	cJSON_Hooks hooks = { countingMalloc, free };
+	cJSON_Arena arena;
+	size_t used;
+	int i;
+
+	cJSON_InitHooks(&hooks);
+	cJSON_InitArena(&arena, storage, sizeof(storage));
+	heapAllocations = 0;
+
+	for (i = 0; i < 100; i++) {
+		CHECK(cJSON_ParseWithArena(command, sizeof(command), NULL, 1, &arena) != NULL);
+		used = arena.offset;
+		CHECK(used > 0);
+		CHECK_EQ(arena.high_water_mark, used);
+		cJSON_ResetArena(&arena);
+		CHECK_EQ(arena.offset, 0);
+	}
+	CHECK_EQ(heapAllocations, 0);
+	cJSON_InitHooks(NULL);
+}
+
+// A failed parse, malformed or out of space, rolls the arena back
+static void testRollback(void)
+{
+	static double storage[256];
+	static const char malformed[] = "{\"command\":\"SET\",\"nodeID\":}";
+	cJSON_Arena arena;
+	size_t before;
+
+	cJSON_InitArena(&arena, storage, sizeof(storage));
+	CHECK(cJSON_ParseWithArena("[1]", 4, NULL, 1, &arena) != NULL);
+	before = arena.offset;
+
+	CHECK(cJSON_ParseWithArena(malformed, sizeof(malformed), NULL, 1, &arena) == NULL);
+	CHECK_EQ(arena.offset, before);
+
+	cJSON_InitArena(&arena, storage, 3 * sizeof(cJSON));
+	CHECK(cJSON_ParseWithArena(command, sizeof(command), NULL, 1, &arena) == NULL);
+	CHECK_EQ(arena.offset, 0);
+
+	cJSON_InitArena(&arena, NULL, sizeof(storage));
+	CHECK(cJSON_ParseWithArena(command, sizeof(command), NULL, 1, &arena) == NULL);
+}
+
+int main(void)
+{
+	testAlignment();
+	testNoHeap();
+	testRollback();
+	return testReport("test_arena");
+}
@@ -0,0 +1,112 @@
+/*
+ * test_auto_baud.c
+ *
+ * MCAL_USART_Auto_Baud_BRR: edge times of a '{' at every standard rate,
+ * with interrupt latency and across a wrap of the cycle counter, and edges
+ * that must be refused.
+ */
+
+#include "usart_host.h"
+#include "test.h"
+
+#define STANDARD_RATES (sizeof(Global_USART_Standard_Baud_Rates) / sizeof(Global_USART_Standard_Baud_Rates[0]))
+
+// Bit times of the edges of a '{' (0x7B): see MCAL_USART_Auto_Baud_BRR
+static const uint8_t braceEdges[USART_AUTO_BAUD_EDGES] = { 0, 1, 3, 4, 8, 9 };
+
+// 'A' (0x41) starts the same way but its third edge is a bit early
+static const uint8_t letterEdges[USART_AUTO_BAUD_EDGES] = { 0, 1, 2, 7, 8, 9 };
+
+static uint32_t seed = 12345;
+
+static uint32_t nextRandom(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return seed >> 16;
+}
+
+// Cycle counter value of every edge, each one late by up to maxLatency cycles
+static void makeEdges(uint32_t *times, const uint8_t *bits, uint32_t start, uint32_t hclk, uint32_t baudRate, uint32_t maxLatency)
+{
+	int i;
+
+	for (i = 0; i < USART_AUTO_BAUD_EDGES; i++) {
+		uint32_t latency = (maxLatency != 0) ? nextRandom() % (maxLatency + 1) : 0;
+
+		times[i] = start + (uint32_t)(((uint64_t)hclk * bits[i] + baudRate / 2) / baudRate) + latency;
+	}
+}
+
+static void checkStandardRates(uint32_t hclk, uint32_t pclk, uint32_t maxLatency)
+{
+	static const uint32_t starts[] = { 0, 123456789, 0xFFFFFF00 };	// the last one wraps during the '{'
+	uint32_t times[USART_AUTO_BAUD_EDGES];
+	size_t rate, start;
+	int round;
+
+	for (rate = 0; rate < STANDARD_RATES; rate++) {
+		uint32_t baudRate = Global_USART_Standard_Baud_Rates[rate];
+		uint32_t errorPpm;
+		uint16_t expected = MCAL_USART_Calculate_BRR(pclk, baudRate, &errorPpm);
+
+		// Rates the USART can't run at from this clock are refused
+		if (errorPpm > USART_BAUD_MAX_ERROR_PPM) {
+			expected = 0;
+		}
+
+		for (start = 0; start < sizeof(starts) / sizeof(starts[0]); start++) {
+			for (round = 0; round < 16; round++) {
+				uint32_t detected = 0;
+
+				makeEdges(times, braceEdges, starts[start], hclk, baudRate, maxLatency);
+				CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, hclk, pclk, &detected), expected);
+				if (expected != 0) {
+					CHECK_EQ(detected, baudRate);
+				}
+			}
+		}
+	}
+}
+
+static void checkRefused(void)
+{
+	uint32_t times[USART_AUTO_BAUD_EDGES];
+	uint32_t detected = 0;
+
+	// Another character
+	makeEdges(times, letterEdges, 1000, 72000000, 115200, 0);
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 72000000, 72000000, &detected), 0);
+
+	// A '{' 10% off any standard rate
+	makeEdges(times, braceEdges, 1000, 72000000, 126720, 0);
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 72000000, 72000000, &detected), 0);
+
+	// An edge a third of a bit late
+	makeEdges(times, braceEdges, 1000, 72000000, 9600, 0);
+	times[2] += 72000000 / 9600 / 3;
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 72000000, 72000000, &detected), 0);
+
+	// All edges at once, no clocks
+	memset(times, 0, sizeof(times));
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 72000000, 72000000, &detected), 0);
+	makeEdges(times, braceEdges, 1000, 72000000, 9600, 0);
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 0, 72000000, &detected), 0);
+	CHECK_EQ(MCAL_USART_Auto_Baud_BRR(times, 72000000, 0, &detected), 0);
+
+	CHECK_EQ(detected, 0);
+}
+
+int main(void)
+{
+	// The board: HCLK 8 MHz, USART1 on PCLK2 = HCLK
+	checkStandardRates(8000000, 8000000, 0);
+	checkStandardRates(8000000, 8000000, 1);
+
+	// 72 MHz with up to 12 cycles of interrupt latency, a sixth of a bit at 921600 baud
+	checkStandardRates(72000000, 72000000, 0);
+	checkStandardRates(72000000, 72000000, 12);
+	checkStandardRates(72000000, 36000000, 12);
+
+	checkRefused();
+	return testReport("test_auto_baud");
+}
@@ -0,0 +1,205 @@
+/*
+ * test_cobs_frame.c
+ *
+ * Binary framing of the command link: CRC16 check value, COBS round trips of
+ * every payload length, and frames that are corrupted, truncated, too long
+ * or not binary at all.
+ */
+
+#include "cobs_frame.h"
+#include "test.h"
+
+static uint32_t seed = 2024;
+
+static uint8_t nextByte(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (uint8_t)(seed >> 16);
+}
+
+// Feed bytes to the decoder, returns the result of the last one and counts the frames and errors on the way
+static CobsFrameResult feed(CobsDecoder *decoder, const uint8_t *bytes, uint16_t length, int *frames, int *errors)
+{
+	CobsFrameResult result = COBS_FRAME_NONE;
+	uint16_t i;
+
+	for (i = 0; i < length; i++) {
+		result = cobsDecoderPush(decoder, bytes[i]);
+		if (result == COBS_FRAME_OK) {
+			(*frames)++;
+		}
+		else if (result == COBS_FRAME_ERROR) {
+			(*errors)++;
+		}
+	}
+	return result;
+}
+
+static void checkCrc(void)
+{
+	static const uint8_t check[] = "123456789";
+	uint8_t withCrc[11];
+	uint16_t crc = crc16Ccitt(COBS_FRAME_CRC_INIT, check, 9);
+
+	// CRC-16/CCITT-FALSE check value
+	CHECK_EQ(crc, 0x29B1);
+
+	// Continuing over a split gives the same CRC
+	CHECK_EQ(crc16Ccitt(crc16Ccitt(COBS_FRAME_CRC_INIT, check, 4), &check[4], 5), crc);
+
+	// Running it over the data and its big endian CRC leaves 0, which is how the decoder checks frames
+	memcpy(withCrc, check, 9);
+	withCrc[9] = (uint8_t)(crc >> 8);
+	withCrc[10] = (uint8_t)crc;
+	CHECK_EQ(crc16Ccitt(COBS_FRAME_CRC_INIT, withCrc, 11), 0);
+}
+
+// Payloads of every length: random, all zeros and no zeros at all
+static void makePayload(uint8_t *payload, uint16_t length, int pattern)
+{
+	uint16_t i;
+
+	for (i = 0; i < length; i++) {
+		switch (pattern) {
+		case 0: payload[i] = nextByte(); break;
+		case 1: payload[i] = 0; break;
+		default: payload[i] = (uint8_t)(nextByte() | 1); break;
+		}
+	}
+}
+
+static void checkRoundTrip(void)
+{
+	uint8_t payload[COBS_FRAME_MAX_PAYLOAD];
+	uint8_t encoded[COBS_FRAME_MAX_ENCODED];
+	CobsDecoder decoder;
+	uint16_t length, encodedLength, i;
+	int pattern;
+
+	cobsDecoderInit(&decoder);
+	for (pattern = 0; pattern < 3; pattern++) {
+		for (length = 0; length <= COBS_FRAME_MAX_PAYLOAD; length++) {
+			uint8_t type = (uint8_t)(pattern * 0x10 + 1);
+			int frames = 0, errors = 0;
+			int zeros = 0;
+
+			makePayload(payload, length, pattern);
+			encodedLength = cobsEncodeFrame(type, payload, length, encoded);
+			CHECK(encodedLength <= COBS_FRAME_MAX_ENCODED);
+			CHECK_EQ(encodedLength, length + 5);
+
+			// 0x00 only ends the frame
+			for (i = 0; i < encodedLength; i++) {
+				zeros += (encoded[i] == 0);
+			}
+			CHECK_EQ(zeros, 1);
+			CHECK_EQ(encoded[encodedLength - 1], 0);
+
+			CHECK_EQ(feed(&decoder, encoded, encodedLength, &frames, &errors), COBS_FRAME_OK);
+			CHECK_EQ(frames, 1);
+			CHECK_EQ(errors, 0);
+			CHECK_EQ(cobsFrameType(&decoder), type);
+			CHECK_EQ(cobsFramePayloadLength(&decoder), length);
+			CHECK(memcmp(cobsFramePayload(&decoder), payload, length) == 0);
+		}
+	}
+
+	// Longer payloads are refused
+	CHECK_EQ(cobsEncodeFrame(1, payload, COBS_FRAME_MAX_PAYLOAD + 1, encoded), 0);
+}
+
+static void checkCorrupted(void)
+{
+	uint8_t payload[COBS_FRAME_MAX_PAYLOAD];
+	uint8_t encoded[COBS_FRAME_MAX_ENCODED];
+	uint8_t corrupted[COBS_FRAME_MAX_ENCODED];
+	CobsDecoder decoder;
+	uint16_t length, encodedLength, i;
+	int bit;
+
+	cobsDecoderInit(&decoder);
+	for (length = 0; length <= COBS_FRAME_MAX_PAYLOAD; length += 5) {
+		makePayload(payload, length, 0);
+		encodedLength = cobsEncodeFrame(0x21, payload, length, encoded);
+
+		// Every single bit error before the delimiter
+		for (i = 0; i + 1 < encodedLength; i++) {
+			for (bit = 0; bit < 8; bit++) {
+				int frames = 0, errors = 0;
+
+				memcpy(corrupted, encoded, encodedLength);
+				corrupted[i] ^= (uint8_t)(1 << bit);
+				feed(&decoder, corrupted, encodedLength, &frames, &errors);
+				CHECK_EQ(frames, 0);
+				CHECK(errors >= 1);
+			}
+		}
+
+		// Truncated: the delimiter arrives early
+		for (i = 1; i + 1 < encodedLength; i++) {
+			int frames = 0, errors = 0;
+
+			memcpy(corrupted, encoded, i);
+			corrupted[i] = 0;
+			CHECK_EQ(feed(&decoder, corrupted, i + 1, &frames, &errors), COBS_FRAME_ERROR);
+			CHECK_EQ(frames, 0);
+		}
+	}
+}
+
+static void checkStream(void)
+{
+	static const char json[] = "{\"command\":\"ENA\",\"nodeID\":128}\r\n";
+	uint8_t encoded[COBS_FRAME_MAX_ENCODED];
+	uint8_t tooLong[COBS_FRAME_MAX_ENCODED + 8];
+	uint8_t payload[4] = { 0x80, 0x00, 0x01, 0x02 };
+	CobsDecoder decoder;
+	uint16_t encodedLength;
+	int frames = 0, errors = 0;
+
+	cobsDecoderInit(&decoder);
+	encodedLength = cobsEncodeFrame(0x11, payload, sizeof(payload), encoded);
+
+	// Delimiters between frames are not errors
+	CHECK_EQ(cobsDecoderPush(&decoder, 0), COBS_FRAME_NONE);
+	CHECK_EQ(cobsDecoderPush(&decoder, 0), COBS_FRAME_NONE);
+
+	// JSON text is never taken for a frame: '{' reads as a block longer than the text
+	feed(&decoder, (const uint8_t *)json, sizeof(json) - 1, &frames, &errors);
+	CHECK_EQ(frames, 0);
+	CHECK_EQ(cobsDecoderPush(&decoder, 0), COBS_FRAME_ERROR);
+
+	// A frame that doesn't fit is dropped as soon as it overflows
+	frames = 0;
+	errors = 0;
+	memset(tooLong, 0x55, sizeof(tooLong));
+	tooLong[0] = 0xFF;
+	feed(&decoder, tooLong, sizeof(tooLong), &frames, &errors);
+	CHECK_EQ(frames, 0);
+	CHECK(errors >= 1);
+
+	// After a delimiter the decoder is back in step
+	frames = 0;
+	errors = 0;
+	cobsDecoderPush(&decoder, 0);
+	CHECK_EQ(feed(&decoder, encoded, encodedLength, &frames, &errors), COBS_FRAME_OK);
+	CHECK_EQ(frames, 1);
+	CHECK_EQ(cobsFramePayloadLength(&decoder), sizeof(payload));
+	CHECK(memcmp(cobsFramePayload(&decoder), payload, sizeof(payload)) == 0);
+
+	// Back to back frames
+	frames = 0;
+	feed(&decoder, encoded, encodedLength, &frames, &errors);
+	feed(&decoder, encoded, encodedLength, &frames, &errors);
+	CHECK_EQ(frames, 2);
+	CHECK_EQ(errors, 0);
+}
+
+int main(void)
+{
+	checkCrc();
+	checkRoundTrip();
+	checkCorrupted();
+	checkStream();
+	return testReport("test_cobs_frame");
+}
@@ -0,0 +1,224 @@
+/*
+ * test_command_table.c
+ *
+ * Command dispatcher: the perfect hash of the command names, every three
+ * letter string that is not a command, and the handler each command gets
+ * for each type of node.
+ */
+
+#include "command_table.h"
+#include "test.h"
+
+#define SENSOR_ID 128
+#define ACTUATOR_ID 80
+#define UNREGISTERED_ID 7
+
+static const NodeConfig configs[] = {
+	{ SENSOR_ID, NODE_TYPE_SENSOR, NULL, 1, 0, 1, 5, NODE_TEXT("C") },
+	{ ACTUATOR_ID, NODE_TYPE_ACTUATOR, NULL, 0, 0, 8, 0, NODE_TEXT("") }
+};
+static NodeState states[2];
+
+// What the last dispatch did
+static CommandHandler calledHandler;
+static uint8_t calledSlot;
+static int handlerCalls;
+static const char *doneType;
+static int doneNodeID;
+static int doneCalls;
+
+void sendNodeMessage(const char *nodeType, int nodeID, const char *data, uint16_t dataLength)
+{
+	CHECK_EQ(dataLength, 4);
+	CHECK(memcmp(data, "DONE", 4) == 0);
+
+	// The reply is sent before the handler runs
+	CHECK_EQ(handlerCalls, 0);
+	doneType = nodeType;
+	doneNodeID = nodeID;
+	doneCalls++;
+}
+
+#define STUB_HANDLER(name)											\
+	void name(const JsonMessage *jsonMsg, uint8_t slot)				\
+	{																\
+		(void)jsonMsg;												\
+		calledHandler = name;										\
+		calledSlot = slot;											\
+		handlerCalls++;												\
+	}
+
+STUB_HANDLER(enableSensor)
+STUB_HANDLER(enableActuator)
+STUB_HANDLER(disableSensor)
+STUB_HANDLER(disableActuator)
+STUB_HANDLER(setActuator)
+STUB_HANDLER(reportNodeStatus)
+STUB_HANDLER(setSensorPeriod)
+STUB_HANDLER(setBaudRate)
+STUB_HANDLER(reportLinkStatus)
+STUB_HANDLER(detectBaudRate)
+STUB_HANDLER(selectBinaryFraming)
+STUB_HANDLER(selectJsonFraming)
+
+static void checkNames(void)
+{
+	uint8_t code, other;
+
+	for (code = 0; code < CMD_COUNT; code++) {
+		CHECK_EQ(commandCodeOf(commandNames[code]), code);
+
+		// Every command has a slot of its own
+		for (other = 0; other < code; other++) {
+			CHECK(COMMAND_HASH(commandNames[code][0], commandNames[code][1], commandNames[code][2])
+					!= COMMAND_HASH(commandNames[other][0], commandNames[other][1], commandNames[other][2]));
+		}
+	}
+}
+
+// Code a linear search of the names would give
+static uint8_t searchName(const char *command)
+{
+	uint8_t code;
+
+	for (code = 0; code < CMD_COUNT; code++) {
+		if (strcmp(commandNames[code], command) == 0) {
+			return code;
+		}
+	}
+	return CMD_UNKNOWN;
+}
+
+static void checkNonCommands(void)
+{
+	static const char *const others[] = { "", "E", "EN", "ENAB", "ENA ", " ENA", "ena", "Ena", "ENa", "ACTUATE", "DONE" };
+	char command[4] = { 0 };
+	int c0, c1, c2;
+	size_t i;
+
+	// Names of any three bytes (every third middle byte), only a mismatch is counted as a check
+	for (c0 = 1; c0 < 256; c0++) {
+		for (c1 = 1; c1 < 256; c1 += 3) {
+			for (c2 = 1; c2 < 256; c2++) {
+				command[0] = (char)c0;
+				command[1] = (char)c1;
+				command[2] = (char)c2;
+				if (commandCodeOf(command) != searchName(command)) {
+					CHECK_EQ(commandCodeOf(command), searchName(command));
+				}
+			}
+		}
+	}
+
+	// All uppercase names, counted once each
+	for (c0 = 'A'; c0 <= 'Z'; c0++) {
+		for (c1 = 'A'; c1 <= 'Z'; c1++) {
+			for (c2 = 'A'; c2 <= 'Z'; c2++) {
+				command[0] = (char)c0;
+				command[1] = (char)c1;
+				command[2] = (char)c2;
+				CHECK_EQ(commandCodeOf(command), searchName(command));
+			}
+		}
+	}
+
+	for (i = 0; i < sizeof(others) / sizeof(others[0]); i++) {
+		CHECK_EQ(commandCodeOf(others[i]), CMD_UNKNOWN);
+	}
+}
+
+static void dispatch(uint8_t commandCode, int nodeID)
+{
+	JsonMessage jsonMsg;
+
+	memset(&jsonMsg, 0, sizeof(jsonMsg));
+	jsonMsg.nodeID = nodeID;
+	jsonMsg.commandCode = commandCode;
+	calledHandler = NULL;
+	calledSlot = 0;
+	handlerCalls = 0;
+	doneType = NULL;
+	doneNodeID = -1;
+	doneCalls = 0;
+	dispatchCommand(&jsonMsg);
+}
+
+static void checkDispatch(void)
+{
+	CHECK_EQ(nodeRegistryInit(configs, states, 2), 2);
+
+	dispatch(CMD_ENA, SENSOR_ID);
+	CHECK(calledHandler == enableSensor);
+	CHECK_EQ(calledSlot, 0);
+	CHECK_STR(doneType, "NS");
+	CHECK_EQ(doneNodeID, SENSOR_ID);
+
+	dispatch(CMD_ENA, ACTUATOR_ID);
+	CHECK(calledHandler == enableActuator);
+	CHECK_EQ(calledSlot, 1);
+	CHECK_STR(doneType, "NA");
+
+	dispatch(CMD_DIS, SENSOR_ID);
+	CHECK(calledHandler == disableSensor);
+	dispatch(CMD_DIS, ACTUATOR_ID);
+	CHECK(calledHandler == disableActuator);
+
+	// ACT only drives actuators and DUR only times sensors, without a DONE
+	dispatch(CMD_ACT, ACTUATOR_ID);
+	CHECK(calledHandler == setActuator);
+	CHECK_EQ(doneCalls, 0);
+	dispatch(CMD_ACT, SENSOR_ID);
+	CHECK_EQ(handlerCalls, 0);
+	dispatch(CMD_DUR, SENSOR_ID);
+	CHECK(calledHandler == setSensorPeriod);
+	dispatch(CMD_DUR, ACTUATOR_ID);
+	CHECK_EQ(handlerCalls, 0);
+
+	dispatch(CMD_STA, SENSOR_ID);
+	CHECK(calledHandler == reportNodeStatus);
+	dispatch(CMD_STA, UNREGISTERED_ID);
+	CHECK_EQ(handlerCalls, 0);
+
+	// Node commands to an ID that is not registered are ignored
+	dispatch(CMD_ENA, UNREGISTERED_ID);
+	CHECK_EQ(handlerCalls, 0);
+	CHECK_EQ(doneCalls, 0);
+	dispatch(CMD_ENA, -1);
+	CHECK_EQ(handlerCalls, 0);
+
+	// Link commands run whatever the node ID is
+	dispatch(CMD_LNK, UNREGISTERED_ID);
+	CHECK(calledHandler == reportLinkStatus);
+	CHECK_EQ(calledSlot, NODE_NOT_FOUND);
+	dispatch(CMD_BAU, SENSOR_ID);
+	CHECK(calledHandler == setBaudRate);
+	dispatch(CMD_ABD, UNREGISTERED_ID);
+	CHECK(calledHandler == detectBaudRate);
+	CHECK_STR(doneType, "SYS");
+	CHECK_EQ(doneNodeID, UNREGISTERED_ID);
+	dispatch(CMD_BIN, ACTUATOR_ID);
+	CHECK(calledHandler == selectBinaryFraming);
+	CHECK_EQ(doneCalls, 0);
+	dispatch(CMD_JSN, UNREGISTERED_ID);
+	CHECK(calledHandler == selectJsonFraming);
+	CHECK_STR(doneType, "SYS");
+
+	// Not a command
+	dispatch(CMD_UNKNOWN, SENSOR_ID);
+	CHECK_EQ(handlerCalls, 0);
+	CHECK_EQ(doneCalls, 0);
+	dispatch(CMD_COUNT, SENSOR_ID);
+	CHECK_EQ(handlerCalls, 0);
+
+	CHECK(commandLookup(CMD_UNKNOWN, SENSOR_ID) == NULL);
+	CHECK(commandLookup(CMD_ACT, ACTUATOR_ID)->handler == setActuator);
+	CHECK(commandLookup(CMD_ACT, UNREGISTERED_ID)->handler == NULL);
+}
+
+int main(void)
+{
+	checkNames();
+	checkNonCommands();
+	checkDispatch();
+	return testReport("test_command_table");
+}
@@ -0,0 +1,144 @@
+/*
+ * test_deadline_heap.c
+ *
+ * Deadline heap of the sampler: entries come out earliest first, also when
+ * the due times straddle a wrap of the tick count, and a simulated sampler
+ * keeps every node on its period across the wrap.
+ */
+
+#include "deadline_heap.h"
+#include "test.h"
+
+static uint32_t seed = 99;
+
+static uint32_t nextRandom(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return seed >> 8;
+}
+
+static void checkBefore(void)
+{
+	CHECK(DEADLINE_BEFORE(1, 2));
+	CHECK(!DEADLINE_BEFORE(2, 1));
+	CHECK(!DEADLINE_BEFORE(5, 5));
+	CHECK(DEADLINE_BEFORE(0xFFFFFFF0u, 0x10));
+	CHECK(!DEADLINE_BEFORE(0x10, 0xFFFFFFF0u));
+	CHECK(DEADLINE_BEFORE(0x7FFFFFFFu, 0x80000000u));
+}
+
+static void checkEmptyAndFull(void)
+{
+	DeadlineHeap heap;
+	uint8_t i;
+
+	deadlineHeapInit(&heap);
+	CHECK(deadlineHeapTop(&heap) == NULL);
+	deadlineHeapPop(&heap);
+	CHECK_EQ(heap.count, 0);
+
+	for (i = 0; i < NODE_MAX; i++) {
+		CHECK_EQ(deadlineHeapPush(&heap, i, 100 - i), 1);
+	}
+	CHECK_EQ(deadlineHeapPush(&heap, NODE_MAX, 0), 0);
+	CHECK_EQ(heap.count, NODE_MAX);
+	CHECK_EQ(deadlineHeapTop(&heap)->slot, NODE_MAX - 1);
+}
+
+// Fill the heap with due times within span ticks after base, then pop them all in order
+static void checkOrder(uint32_t base, uint32_t span, uint8_t count)
+{
+	DeadlineHeap heap;
+	uint32_t dues[NODE_MAX];
+	uint8_t popped[NODE_MAX];
+	uint32_t previous = base;
+	uint8_t i;
+
+	deadlineHeapInit(&heap);
+	memset(popped, 0, sizeof(popped));
+	for (i = 0; i < count; i++) {
+		dues[i] = base + nextRandom() % span;
+		CHECK_EQ(deadlineHeapPush(&heap, i, dues[i]), 1);
+	}
+
+	for (i = 0; i < count; i++) {
+		const Deadline *top = deadlineHeapTop(&heap);
+
+		CHECK(top != NULL);
+		if (top == NULL) {
+			return;
+		}
+		CHECK_EQ(top->due, dues[top->slot]);
+		CHECK(!DEADLINE_BEFORE(top->due, previous));
+		CHECK_EQ(popped[top->slot], 0);
+		popped[top->slot] = 1;
+		previous = top->due;
+		deadlineHeapPop(&heap);
+	}
+	CHECK(deadlineHeapTop(&heap) == NULL);
+}
+
+// The sampler: take the earliest node, read it and push it back one period later
+static void checkSampler(void)
+{
+	static const uint32_t periods[] = { 1000, 1000, 2000, 3000, 5000, 7000, 250 };
+	uint8_t count = sizeof(periods) / sizeof(periods[0]);
+	uint32_t nextDue[sizeof(periods) / sizeof(periods[0])];
+	uint32_t readings[sizeof(periods) / sizeof(periods[0])];
+	uint32_t start = 0xFFFFFFFFu - 20000;	// the tick count wraps after 20 seconds
+	uint32_t now = start;
+	DeadlineHeap heap;
+	uint8_t slot;
+	int step;
+
+	deadlineHeapInit(&heap);
+	for (slot = 0; slot < count; slot++) {
+		nextDue[slot] = start + periods[slot];
+		readings[slot] = 0;
+		deadlineHeapPush(&heap, slot, nextDue[slot]);
+	}
+
+	for (step = 0; step < 2000; step++) {
+		const Deadline *top = deadlineHeapTop(&heap);
+		uint32_t due = top->due;
+
+		slot = top->slot;
+
+		// Time never goes back, and no other node was due earlier
+		CHECK(!DEADLINE_BEFORE(due, now));
+		CHECK_EQ(due, nextDue[slot]);
+		now = due;
+		readings[slot]++;
+
+		deadlineHeapPop(&heap);
+		nextDue[slot] = due + periods[slot];
+		deadlineHeapPush(&heap, slot, nextDue[slot]);
+	}
+
+	// Well past the wrap, every node was read once per period
+	CHECK(DEADLINE_BEFORE(0, now) && (now > 20000));
+	for (slot = 0; slot < count; slot++) {
+		uint32_t elapsed = now - start;
+
+		CHECK(readings[slot] >= elapsed / periods[slot] - 1);
+		CHECK(readings[slot] <= elapsed / periods[slot] + 1);
+	}
+}
+
+int main(void)
+{
+	int round;
+
+	checkBefore();
+	checkEmptyAndFull();
+	for (round = 0; round < 200; round++) {
+		uint8_t count = (uint8_t)(1 + round % NODE_MAX);
+
+		checkOrder(1000, 100000, count);
+		checkOrder(0xFFFFFFFFu - 50000, 100000, count);	// half of them after the wrap
+		checkOrder(0x7FFFFFF0u, 64, count);				// across the sign bit of the difference
+		checkOrder(5000, 3, count);						// many equal due times
+	}
+	checkSampler();
+	return testReport("test_deadline_heap");
+}
@@ -0,0 +1,82 @@
+/*
+ * test_in_situ.c
+ *
+ * In-situ parsing (CJSON_IN_SITU): strings are unescaped in the input and referenced by the tree.
+ */
+
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+#define IN(ptr, buf)	(((const char *)(ptr) >= (buf)) && ((const char *)(ptr) < (buf) + sizeof(buf)))
+
+// Names and values point into the input, escapes are resolved in place
+static void testReferences(void)
+{
+	static double storage[128];
+	char input[] = "{\"command\":\"SET\",\"nodeID\":130,\"data\":\"a\\\"b\\\\c\\u00e9\\n\",\"list\":[\"x\",\"\"]}";
+	cJSON_Arena arena;
+	cJSON *root, *data, *list;
+
+	cJSON_InitArena(&arena, storage, sizeof(storage));
+	root = cJSON_ParseInSitu(input, sizeof(input), NULL, 1, &arena);
+	CHECK(root != NULL);
+	if (root == NULL)
+		return;
+
+	data = cJSON_GetObjectItemCaseSensitive(root, "data");
+	list = cJSON_GetObjectItemCaseSensitive(root, "list");
+	CHECK_STR(cJSON_GetObjectItemCaseSensitive(root, "command")->valuestring, "SET");
+	CHECK_STR(data->valuestring, "a\"b\\c\xc3\xa9\n");
+	CHECK_STR(cJSON_GetArrayItem(list, 0)->valuestring, "x");
+	CHECK_STR(cJSON_GetArrayItem(list, 1)->valuestring, "");
+	CHECK_EQ(cJSON_GetObjectItemCaseSensitive(root, "nodeID")->valueint, 130);
+
+	CHECK(IN(data->valuestring, input));
+	CHECK(IN(data->string, input));
+	CHECK(IN(cJSON_GetArrayItem(list, 1)->valuestring, input));
+	CHECK(!IN(root, input));
+}
+
+// Without an arena the nodes come from the hooks and are freed with cJSON_Delete
+static void testWithoutArena(void)
+{
+	char input[] = "{\"a\":\"1\",\"b\":[true,false,null]}";
+	cJSON *root = cJSON_ParseInSitu(input, sizeof(input), NULL, 1, NULL);
+
+	CHECK(root != NULL);
+	CHECK_STR(cJSON_GetObjectItemCaseSensitive(root, "a")->valuestring, "1");
+	CHECK(IN(cJSON_GetObjectItemCaseSensitive(root, "a")->valuestring, input));
+	CHECK(cJSON_IsTrue(cJSON_GetArrayItem(cJSON_GetObjectItemCaseSensitive(root, "b"), 0)));
+	cJSON_Delete(root);
+}
+
+// A failed parse returns NULL, rolls the arena back, and leaves the input modified as documented
+static void testFailure(void)
+{
+	static double storage[128];
+	static const char original[] = "{\"command\":\"SET\",\"data\":\"x\\ty\",\"nodeID\":}";
+	char input[sizeof(original)];
+	const char *end = NULL;
+	cJSON_Arena arena;
+
+	memcpy(input, original, sizeof(input));
+	cJSON_InitArena(&arena, storage, sizeof(storage));
+	CHECK(cJSON_ParseInSitu(input, sizeof(input), &end, 1, &arena) == NULL);
+	CHECK_EQ(arena.offset, 0);
+	CHECK(end != NULL && IN(end, input));
+	CHECK(memcmp(input, original, sizeof(input)) != 0);
+
+	// the arena is usable again for the next message
+	memcpy(input, "[1]", 4);
+	CHECK(cJSON_ParseInSitu(input, 4, NULL, 1, &arena) != NULL);
+	CHECK(arena.offset > 0);
+}
+
+int main(void)
+{
+	testReferences();
+	testWithoutArena();
+	testFailure();
+	return testReport("test_in_situ");
+}
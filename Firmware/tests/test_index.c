@@ -0,0 +1,122 @@
+/*
+ * test_index.c
+ *
+ * Hash index of wide objects (CJSON_INDEX): lookups through the index and its invalidation by the modifying APIs.
+ */
+
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+#define WIDE (CJSON_INDEX_THRESHOLD * 3)
+
+static cJSON *wideObject(void)
+{
+	cJSON *object = cJSON_CreateObject();
+	char name[16];
+	int i;
+
+	for (i = 0; i < WIDE; i++) {
+		snprintf(name, sizeof(name), "Key%d", i);
+		cJSON_AddNumberToObject(object, name, i);
+	}
+	return object;
+}
+
+// Every child is found through the index, with both kinds of lookup
+static void testLookup(void)
+{
+	cJSON *object = wideObject();
+	char name[16];
+	int i;
+
+	for (i = 0; i < WIDE; i++) {
+		snprintf(name, sizeof(name), "Key%d", i);
+		CHECK_EQ(cJSON_GetObjectItemCaseSensitive(object, name)->valueint, i);
+		snprintf(name, sizeof(name), "kEY%d", i);
+		CHECK_EQ(cJSON_GetObjectItem(object, name)->valueint, i);
+		CHECK(cJSON_GetObjectItemCaseSensitive(object, name) == NULL);
+	}
+	CHECK(object->index != NULL);
+	CHECK(cJSON_GetObjectItem(object, "missing") == NULL);
+
+	// a duplicate name finds the first child, as without the index
+	cJSON_AddStringToObject(object, "Key3", "second");
+	CHECK(cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(object, "Key3")));
+
+	// narrow objects are never indexed
+	cJSON_Delete(object);
+	object = cJSON_CreateObject();
+	cJSON_AddNullToObject(object, "a");
+	CHECK(cJSON_GetObjectItem(object, "a") != NULL);
+	CHECK(object->index == NULL);
+	cJSON_Delete(object);
+}
+
+// Adding, inserting, detaching and replacing children drop the index, lookups see the change
+static void testInvalidation(void)
+{
+	cJSON *object = wideObject();
+
+	CHECK(cJSON_GetObjectItem(object, "Key0") != NULL);
+	CHECK(object->index != NULL);
+	cJSON_AddStringToObject(object, "added", "yes");
+	CHECK(object->index == NULL);
+	CHECK_STR(cJSON_GetObjectItem(object, "added")->valuestring, "yes");
+
+	cJSON_DeleteItemFromObjectCaseSensitive(object, "Key5");
+	CHECK(cJSON_GetObjectItem(object, "Key5") == NULL);
+	CHECK(cJSON_GetObjectItem(object, "Key6") != NULL);
+
+	cJSON_ReplaceItemInObjectCaseSensitive(object, "Key7", cJSON_CreateString("seven"));
+	CHECK_STR(cJSON_GetObjectItemCaseSensitive(object, "Key7")->valuestring, "seven");
+
+	cJSON_InsertItemInArray(object, 0, cJSON_CreateTrue());
+	CHECK(object->index == NULL);
+	cJSON_Delete(cJSON_DetachItemFromObject(object, "Key8"));
+	CHECK(cJSON_GetObjectItem(object, "Key8") == NULL);
+	CHECK_EQ(cJSON_GetObjectItem(object, "Key9")->valueint, 9);
+
+	// duplicates keep the index of the copy apart from the original
+	{
+		cJSON *copy = cJSON_Duplicate(object, 1);
+		CHECK(cJSON_GetObjectItem(copy, "Key10") != NULL);
+		CHECK(copy->index != object->index);
+		cJSON_Delete(copy);
+	}
+	cJSON_Delete(object);
+}
+
+// A wide object parsed into an arena is indexed from the arena while it is parsed
+static void testArena(void)
+{
+	static double storage[2048];
+	cJSON_Arena arena;
+	char text[1024];
+	size_t length = 0;
+	cJSON *root;
+	int i;
+
+	length += snprintf(text + length, sizeof(text) - length, "{");
+	for (i = 0; i < WIDE; i++)
+		length += snprintf(text + length, sizeof(text) - length, "%s\"n%d\":%d", i ? "," : "", i, i * 2);
+	length += snprintf(text + length, sizeof(text) - length, "}");
+
+	cJSON_InitArena(&arena, storage, sizeof(storage));
+	root = cJSON_ParseWithArena(text, length, NULL, 0, &arena);
+	CHECK(root != NULL);
+	if (root == NULL)
+		return;
+	CHECK(root->index != NULL);
+	CHECK((unsigned char *)root->index >= arena.buffer && (unsigned char *)root->index < arena.buffer + arena.size);
+	CHECK_EQ(cJSON_GetObjectItemCaseSensitive(root, "n17")->valueint, 34);
+	CHECK(cJSON_GetObjectItemCaseSensitive(root, "n1000") == NULL);
+}
+
+int main(void)
+{
+	testLookup();
+	testInvalidation();
+	testArena();
+	return testReport("test_index");
+}
@@ -0,0 +1,103 @@
+/*
+ * test_integer.c
+ *
+ * Integers are parsed and printed without strtod and sprintf, the results must be those of the
+ * strtod/sprintf path they replace.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+// valueint as cJSON derives it from the double
+static int saturated(double number)
+{
+	if (number >= INT_MAX)
+		return INT_MAX;
+	if (number <= (double)INT_MIN)
+		return INT_MIN;
+	return (int)number;
+}
+
+static void checkParse(const char *text)
+{
+	cJSON *item = cJSON_Parse(text);
+	double expected = strtod(text, NULL);
+
+	CHECK(cJSON_IsNumber(item));
+	if (item == NULL)
+		return;
+	CHECK(memcmp(&item->valuedouble, &expected, sizeof(double)) == 0);
+	CHECK_EQ(item->valueint, saturated(expected));
+	cJSON_Delete(item);
+}
+
+static void checkPrint(double number)
+{
+	cJSON *item = cJSON_CreateNumber(number);
+	char *printed = cJSON_PrintUnformatted(item);
+	char expected[32];
+
+	snprintf(expected, sizeof(expected), "%d", item->valueint);
+	CHECK_STR(printed, expected);
+	cJSON_free(printed);
+	cJSON_Delete(item);
+}
+
+static void testEdges(void)
+{
+	static const char *const numbers[] = {
+		"0", "-0", "1", "-1", "7", "10", "01", "999999999", "-999999999", "1000000000", "-1000000000",
+		"2147483647", "-2147483648", "2147483648", "-2147483649", "12345678901234567890",
+		"1.5", "-0.0", "1e3", "1E+2", "2.0", "-7e-1"
+	};
+	static const double printed[] = { 0, 1, -1, 9, 10, 123456789, -123456789, 2147483647, -2147483647, -2147483647.0 - 1 };
+	size_t i;
+
+	for (i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+		checkParse(numbers[i]);
+	for (i = 0; i < sizeof(printed) / sizeof(printed[0]); i++)
+		checkPrint(printed[i]);
+
+	// -0 keeps its sign through the strtod path
+	{
+		cJSON *item = cJSON_Parse("-0");
+		CHECK(signbit(item->valuedouble));
+		cJSON_Delete(item);
+	}
+	// a number ends where the digits end, inside a message as well
+	{
+		cJSON *root = cJSON_Parse("[12,-3,4.25,5e1]");
+		CHECK_EQ(cJSON_GetArrayItem(root, 0)->valueint, 12);
+		CHECK_EQ(cJSON_GetArrayItem(root, 1)->valueint, -3);
+		CHECK(cJSON_GetArrayItem(root, 2)->valuedouble == 4.25);
+		CHECK_EQ(cJSON_GetArrayItem(root, 3)->valueint, 50);
+		cJSON_Delete(root);
+	}
+	CHECK(cJSON_Parse("-") == NULL);
+	CHECK(cJSON_Parse("-x") == NULL);
+}
+
+static void testRandom(void)
+{
+	char text[32];
+	int i;
+
+	srand(1);
+	for (i = 0; i < 100000; i++) {
+		int number = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+		number >>= rand() % 31;
+		snprintf(text, sizeof(text), "%d", number);
+		checkParse(text);
+		checkPrint(number);
+	}
+}
+
+int main(void)
+{
+	testEdges();
+	testRandom();
+	return testReport("test_integer");
+}
@@ -0,0 +1,113 @@
+/*
+ * test_node_registry.c
+ *
+ * Node registry: every registered ID is found in its slot, including IDs
+ * that share an index entry, other IDs are not, and a table with too many
+ * nodes or a repeated ID is cut short.
+ */
+
+#include "node_registry.h"
+#include "test.h"
+
+static NodeConfig configs[NODE_MAX + 2];
+static NodeState states[NODE_MAX + 2];
+
+// IDs that collide in the index: 0, 33, 66 and 99 all start at entry 0
+static const uint8_t collidingIds[] = { 0, 33, 66, 99, 128, 129, 80, 255, 224, 7, 31, 32, 64, 96, 160, 192 };
+
+static void makeConfigs(const uint8_t *ids, uint8_t count)
+{
+	uint8_t i;
+
+	memset(configs, 0, sizeof(configs));
+	for (i = 0; i < count; i++) {
+		configs[i].id = ids[i];
+		configs[i].type = (i & 1) ? NODE_TYPE_ACTUATOR : NODE_TYPE_SENSOR;
+		configs[i].period = (uint8_t)(i + 1);
+		configs[i].unit = "";
+	}
+
+	// States are reset by the registry
+	memset(states, 0x5A, sizeof(states));
+}
+
+// Slot of an ID by a linear search of the table, NODE_NOT_FOUND if it is not in the first count configs
+static uint8_t searchId(int nodeID, uint8_t count)
+{
+	uint8_t i;
+
+	for (i = 0; i < count; i++) {
+		if (configs[i].id == nodeID) {
+			return i;
+		}
+	}
+	return NODE_NOT_FOUND;
+}
+
+static void checkFind(void)
+{
+	uint8_t count = sizeof(collidingIds);
+	uint8_t slot;
+	int nodeID;
+
+	makeConfigs(collidingIds, count);
+	CHECK_EQ(nodeRegistryInit(configs, states, count), count);
+	CHECK_EQ(nodeRegistryCount(), count);
+
+	for (nodeID = -2; nodeID <= 0x101; nodeID++) {
+		CHECK_EQ(nodeFind(nodeID), searchId(nodeID, count));
+	}
+
+	for (slot = 0; slot < count; slot++) {
+		CHECK(nodeConfig(slot) == &configs[slot]);
+		CHECK(nodeState(slot) == &states[slot]);
+		CHECK_EQ(nodeTypeOf(configs[slot].id), configs[slot].type);
+
+		// Reset values
+		CHECK_EQ(states[slot].value, 0);
+		CHECK_EQ(states[slot].savedValue, 0);
+		CHECK_EQ(states[slot].period, slot + 1);
+		CHECK_EQ(states[slot].active, 0);
+		CHECK_EQ(states[slot].powered, 0);
+		CHECK_EQ(states[slot].output, NODE_OUTPUT_UNKNOWN);
+	}
+	CHECK_EQ(nodeTypeOf(1), NODE_TYPE_NONE);
+	CHECK_EQ(nodeTypeOf(-1), NODE_TYPE_NONE);
+}
+
+static void checkLimits(void)
+{
+	uint8_t ids[NODE_MAX + 2];
+	uint8_t i;
+
+	// More than NODE_MAX nodes: the first NODE_MAX are registered
+	for (i = 0; i < NODE_MAX + 2; i++) {
+		ids[i] = (uint8_t)(10 + i);
+	}
+	makeConfigs(ids, NODE_MAX + 2);
+	CHECK_EQ(nodeRegistryInit(configs, states, NODE_MAX + 2), NODE_MAX);
+	CHECK_EQ(nodeFind(10 + NODE_MAX - 1), NODE_MAX - 1);
+	CHECK_EQ(nodeFind(10 + NODE_MAX), NODE_NOT_FOUND);
+
+	// A repeated ID ends the registration, the caller sees fewer nodes than it gave
+	ids[3] = ids[1];
+	makeConfigs(ids, 6);
+	CHECK_EQ(nodeRegistryInit(configs, states, 6), 3);
+	CHECK_EQ(nodeFind(ids[1]), 1);
+	CHECK_EQ(nodeFind(ids[4]), NODE_NOT_FOUND);
+
+	// Registering again starts from an empty index
+	makeConfigs(ids, 2);
+	CHECK_EQ(nodeRegistryInit(configs, states, 2), 2);
+	CHECK_EQ(nodeFind(ids[2]), NODE_NOT_FOUND);
+
+	CHECK_EQ(nodeRegistryInit(configs, states, 0), 0);
+	CHECK_EQ(nodeFind(ids[0]), NODE_NOT_FOUND);
+}
+
+int main(void)
+{
+	checkFind();
+	checkLimits();
+	return testReport("test_node_registry");
+}
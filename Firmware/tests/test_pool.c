@@ -0,0 +1,89 @@
+/*
+ * test_pool.c
+ *
+ * Static node and string pools behind the default hooks (CJSON_POOL), built with small pools
+ * so that running out of slots is exercised.
+ */
+
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+static void testReuse(void)
+{
+	static const char command[] = "{\"command\":\"ACT\",\"nodeID\":130,\"data\":\"ON\"}";
+	cJSON_PoolStats stats;
+	cJSON *root;
+	int i;
+
+	for (i = 0; i < 100; i++) {
+		root = cJSON_Parse(command);
+		CHECK(root != NULL);
+		CHECK_STR(cJSON_GetObjectItemCaseSensitive(root, "data")->valuestring, "ON");
+		cJSON_Delete(root);
+	}
+
+	cJSON_GetPoolStats(&stats);
+	CHECK_EQ(stats.nodes_used, 0);
+	CHECK_EQ(stats.strings_used, 0);
+	CHECK_EQ(stats.nodes_high_water_mark, 4);
+	CHECK_EQ(stats.strings_high_water_mark, 5);
+	CHECK_EQ(stats.failures, 0);
+	CHECK_EQ(stats.heap_allocations, 0);
+}
+
+// Strings too long for a slot and print buffers come from the heap and are given back to it
+static void testLarge(void)
+{
+	static const char text[] = "{\"data\":\"a string that is far too long for a slot of the string pool\"}";
+	cJSON_PoolStats before, after;
+	cJSON *root;
+	char *printed;
+
+	cJSON_GetPoolStats(&before);
+	root = cJSON_Parse(text);
+	CHECK(root != NULL);
+	printed = cJSON_PrintUnformatted(root);
+	CHECK_STR(printed, text);
+	cJSON_free(printed);
+	cJSON_Delete(root);
+
+	cJSON_GetPoolStats(&after);
+	CHECK(after.heap_allocations > before.heap_allocations);
+	CHECK_EQ(after.nodes_used, 0);
+	CHECK_EQ(after.strings_used, 0);
+}
+
+// An exhausted pool fails the parse cleanly, and everything taken so far is given back
+static void testExhausted(void)
+{
+	char text[256];
+	size_t length = 0;
+	cJSON_PoolStats stats;
+	int i;
+
+	length += snprintf(text + length, sizeof(text) - length, "[");
+	for (i = 0; i < CJSON_POOL_NODES + CJSON_POOL_STRINGS; i++)
+		length += snprintf(text + length, sizeof(text) - length, "%s%d", i ? "," : "", i);
+	snprintf(text + length, sizeof(text) - length, "]");
+
+	CHECK(cJSON_Parse(text) == NULL);
+	cJSON_GetPoolStats(&stats);
+	CHECK(stats.failures > 0);
+	CHECK_EQ(stats.nodes_used, 0);
+	CHECK_EQ(stats.strings_used, 0);
+	CHECK_EQ(stats.nodes_high_water_mark, CJSON_POOL_NODES);
+
+	// and the pools still serve the next message
+	cJSON_Delete(cJSON_Parse("[1,2,3]"));
+	cJSON_GetPoolStats(&stats);
+	CHECK_EQ(stats.nodes_used, 0);
+}
+
+int main(void)
+{
+	testReuse();
+	testLarge();
+	testExhausted();
+	return testReport("test_pool");
+}
@@ -0,0 +1,173 @@
+/*
+ * test_push.c
+ *
+ * Push tokenizer and schema decoding of commands (cJSON_Push), fed one byte at a time like the UART task does.
+ */
+
+#include <stddef.h>
+#include "cJSON_Push.h"
+#include "test.h"
+
+typedef struct {
+	char command[64];
+	int nodeID;
+	char data[32];
+} Message;
+
+static const cJSON_PushField fields[] = {
+	cJSON_PushFieldOf("command", cJSON_String, Message, command),
+	cJSON_PushFieldOf("nodeID", cJSON_Number, Message, nodeID),
+	cJSON_PushFieldOf("data", cJSON_String, Message, data),
+	cJSON_PushFieldOf("a_field_with_a_long_name", cJSON_Number, Message, nodeID)
+};
+
+static cJSON_PushParser parser;
+static cJSON_PushRecord record;
+static Message message;
+static int completed, failed, errors;
+static size_t endOffset; // parser->offset of the last object end
+
+static void callback(const cJSON_PushParser *p, cJSON_PushEvent event, void *user_data)
+{
+	cJSON_PushRecord *r = (cJSON_PushRecord *)user_data;
+
+	if (event == cJSON_PushMember) {
+		cJSON_PushRecordMember(r, p);
+	} else if (event == cJSON_PushObjectEnd) {
+		endOffset = p->offset;
+		if (cJSON_PushRecordComplete(r, 1UL << 0))
+			completed++;
+		else
+			failed++;
+	} else {
+		// like the firmware, drop the malformed message and start over
+		errors++;
+		memset(&message, 0, sizeof(message));
+		cJSON_PushRecordReset(r);
+	}
+}
+
+// Feed a message and tell whether it decoded to a complete record
+static int decode(const char *text)
+{
+	completed = failed = errors = 0;
+	memset(&message, 0, sizeof(message));
+	cJSON_PushRecordReset(&record);
+	while (*text != '\0')
+		cJSON_PushByte(&parser, (unsigned char)*text++);
+	return (completed == 1) && (failed == 0) && (errors == 0);
+}
+
+// The same message fed as two blocks split at every position, must decode like byte by byte
+static void checkBlocks(const char *text)
+{
+	size_t length = strlen(text), split;
+	int expected = decode(text);
+	Message bytewise = message;
+	int bytewiseErrors = errors;
+
+	for (split = 0; split <= length; split++) {
+		completed = failed = errors = 0;
+		memset(&message, 0, sizeof(message));
+		cJSON_PushRecordReset(&record);
+		cJSON_PushBytes(&parser, (const unsigned char *)text, split);
+		cJSON_PushBytes(&parser, (const unsigned char *)text + split, length - split);
+
+		CHECK_EQ((completed == 1) && (failed == 0) && (errors == 0), expected);
+		CHECK_EQ(errors, bytewiseErrors);
+		CHECK(memcmp(&message, &bytewise, sizeof(message)) == 0);
+		if (completed == 1) {
+			// the closing brace is the last byte of the second block, or of the first when the second is empty
+			CHECK_EQ(endOffset, (split == length) ? length - 1 : length - split - 1);
+		}
+	}
+}
+
+static void testBlocks(void)
+{
+	checkBlocks("{\"command\":\"ENA\",\"nodeID\":128}");
+	checkBlocks("noise {\"command\" : \"A\\u0043T\", \"data\":\"a \\\"quoted\\\" value\", \"nodeID\":80 }");
+	checkBlocks("{\"command\":\"ENA\",\"a_very_long_unknown_key_name\":\"a note that is longer than thirty-two chars\",\"nodeID\":1}");
+	checkBlocks("{\"command\":\"a command that is longer than thirty-two chars\",\"nodeID\":1}");
+	checkBlocks("{\"command\":\"ENA\",\"nodeID\":}{\"command\":\"DIS\",\"nodeID\":2}");
+	CHECK(cJSON_PushBytes(&parser, NULL, 0));
+	CHECK(!cJSON_PushBytes(NULL, (const unsigned char *)"{", 1));
+}
+
+static void testCommands(void)
+{
+	CHECK(decode("{\"command\":\"ENA\",\"nodeID\":128}"));
+	CHECK_STR(message.command, "ENA");
+	CHECK_EQ(message.nodeID, 128);
+
+	CHECK(decode(" {\"command\" : \"ACT\", \"nodeID\": -7, \"data\": \"O\\u004E\", \"x\": [1, {\"}\": \"]\"}], \"y\": null}\r\n"));
+	CHECK_STR(message.command, "ACT");
+	CHECK_STR(message.data, "ON");
+	CHECK_EQ(message.nodeID, -7);
+
+	// bytes before the object are ignored
+	CHECK(decode("garbage{\"command\":\"STA\",\"nodeID\":2147483647}"));
+	CHECK_EQ(message.nodeID, 2147483647);
+
+	CHECK(!decode("{\"nodeID\":1}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"nodeID\":1.5}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"nodeID\":2147483648}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"nodeID\":\"1\"}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"nodeID\":}"));
+	CHECK_EQ(errors, 1);
+	CHECK(!decode("{\"command\":\"ENA\" \"nodeID\":1}"));
+	CHECK_EQ(errors, 1);
+
+	// the tokenizer resynchronises on the next '{'
+	CHECK(!decode("{\"command\":\"ENA\",{\"command\":\"DIS\",\"nodeID\":3}"));
+	CHECK_EQ(errors, 1);
+	CHECK_EQ(completed, 1);
+	CHECK_STR(message.command, "DIS");
+}
+
+// Overlong names and values of unknown members are skipped, the message is still decoded
+static void testOverlongUnknown(void)
+{
+	CHECK(decode("{\"command\":\"ENA\",\"a_very_long_unknown_key_name\":1,\"nodeID\":128}"));
+	CHECK_STR(message.command, "ENA");
+	CHECK_EQ(message.nodeID, 128);
+
+	CHECK(decode("{\"command\":\"ENA\",\"note\":\"a note that is longer than thirty-two chars\",\"nodeID\":128}"));
+	CHECK_EQ(message.nodeID, 128);
+
+	CHECK(decode("{\"command\":\"ENA\",\"a_very_long_unknown_key_name\":\"with an escape \\\" and \\u00e9 past the end\",\"nodeID\":5}"));
+	CHECK_EQ(message.nodeID, 5);
+
+	CHECK(decode("{\"command\":\"ENA\",\"n\":123456789012345678901234567890123456789012345,\"nodeID\":6}"));
+	CHECK_EQ(message.nodeID, 6);
+
+	// still checked to their end
+	CHECK(!decode("{\"command\":\"ENA\",\"note\":\"a note that is longer than thirty-two chars \\q\",\"nodeID\":1}"));
+	CHECK_EQ(errors, 1);
+}
+
+// Overlong values of fields, and overlong names that could be a field, are errors
+static void testOverlongField(void)
+{
+	CHECK(!decode("{\"command\":\"a command that is longer than thirty-two chars\",\"nodeID\":1}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"nodeID\":123456789012345678901234567890123456789012345}"));
+	CHECK(!decode("{\"command\":\"ENA\",\"a_field_with_a_long_name\":1}"));
+	CHECK_EQ(errors, 0);
+	CHECK_EQ(failed, 1);
+
+	// a field fits exactly
+	CHECK(decode("{\"command\":\"0123456789abcdef0123456789abcdef\"}"));
+	CHECK_EQ(strlen(message.command), CJSON_PUSH_VALUE_LENGTH);
+}
+
+int main(void)
+{
+	cJSON_PushInit(&parser, callback, &record);
+	cJSON_PushRecordInit(&record, fields, sizeof(fields) / sizeof(fields[0]), &message);
+
+	testCommands();
+	testOverlongUnknown();
+	testOverlongField();
+	testBlocks();
+	return testReport("test_push");
+}
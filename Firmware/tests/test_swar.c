@@ -0,0 +1,116 @@
+/*
+ * test_swar.c
+ *
+ * Word-at-a-time whitespace and string scanning (CJSON_SWAR). The input is placed at every alignment and
+ * at the very end of its allocation, so AddressSanitizer catches a word load past the end, and the
+ * special bytes are moved through every position of a word.
+ */
+
+#include <stdlib.h>
+#include "cJSON.h"
+#include "test.h"
+
+#define MAX_LENGTH 40
+
+// Parse text of length bytes (not NUL terminated) placed at the end of an allocation
+static cJSON *parseAtEnd(const char *text, size_t length, size_t shift)
+{
+	char *block = malloc(length + shift);
+	cJSON *item;
+
+	memcpy(block + shift, text, length);
+	item = cJSON_ParseWithLengthOpts(block + shift, length, NULL, 0);
+	// strings are copied out of the input, the block isn't needed by the tree
+	free(block);
+	return item;
+}
+
+// Strings of every length, with a quote or backslash escape at every position
+static void testStrings(void)
+{
+	char text[MAX_LENGTH + 8], expected[MAX_LENGTH + 8];
+	size_t length, special, shift;
+
+	for (length = 0; length <= MAX_LENGTH; length++) {
+		for (special = 0; special <= length; special++) {
+			size_t i, n = 0, e = 0;
+
+			text[n++] = '"';
+			for (i = 0; i < length; i++) {
+				// every byte except quote, backslash and NUL
+				unsigned char byte = (unsigned char)(1 + ((i * 37 + length) % 255));
+				if (byte == '"' || byte == '\\')
+					byte = 0xFF;
+				if (i == special) {
+					text[n++] = '\\';
+					byte = (length & 1) ? '"' : '\\';
+				}
+				text[n++] = (char)byte;
+				expected[e++] = (char)byte;
+			}
+			text[n++] = '"';
+			expected[e] = '\0';
+
+			for (shift = 0; shift < sizeof(long); shift++) {
+				cJSON *item = parseAtEnd(text, n, shift);
+				CHECK(cJSON_IsString(item));
+				if (item != NULL) {
+					CHECK_EQ(strlen(item->valuestring), e);
+					CHECK(memcmp(item->valuestring, expected, e) == 0);
+				}
+				cJSON_Delete(item);
+
+				// and unterminated
+				CHECK(parseAtEnd(text, n - 1, shift) == NULL);
+			}
+		}
+	}
+}
+
+// Whitespace runs of every length, made of every byte <= 32, around and between tokens
+static void testWhitespace(void)
+{
+	static const char spaces[] = " \t\r\n\x01\x1f ";
+	char text[4 * MAX_LENGTH + 8];
+	size_t run, shift;
+
+	for (run = 0; run <= MAX_LENGTH; run++) {
+		size_t i, n = 0;
+
+		for (i = 0; i < run; i++)
+			text[n++] = spaces[(i + run) % (sizeof(spaces) - 1)];
+		text[n++] = '[';
+		for (i = 0; i < run; i++)
+			text[n++] = spaces[i % (sizeof(spaces) - 1)];
+		text[n++] = '1';
+		for (i = 0; i < run; i++)
+			text[n++] = ' ';
+		text[n++] = ',';
+		text[n++] = '2';
+		text[n++] = ']';
+		for (i = 0; i < run; i++)
+			text[n++] = '\n';
+
+		for (shift = 0; shift < sizeof(long); shift++) {
+			cJSON *item = parseAtEnd(text, n, shift);
+			CHECK_EQ(cJSON_GetArraySize(item), 2);
+			CHECK_EQ(cJSON_GetArrayItem(item, 1)->valueint, 2);
+			cJSON_Delete(item);
+		}
+
+		// the first byte above 32 ends the run, high bytes included
+		if (run >= 2) {
+			text[run / 2] = '!';
+			CHECK(parseAtEnd(text, n, 0) == NULL);
+			text[run / 2] = (char)0xA0;
+			CHECK(parseAtEnd(text, n, 0) == NULL);
+		}
+	}
+}
+
+int main(void)
+{
+	testStrings();
+	testWhitespace();
+	return testReport("test_swar");
+}
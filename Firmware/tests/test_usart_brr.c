@@ -0,0 +1,112 @@
+/*
+ * test_usart_brr.c
+ *
+ * MCAL_USART_Calculate_BRR: the BRR and error of the standard rates at the
+ * bus clocks the board runs at, and the nearest divider for every rate.
+ */
+
+#include "usart_host.h"
+#include "test.h"
+
+typedef struct
+{
+	uint32_t pclk;
+	uint32_t baudRate;
+	uint16_t brr;			// 0: out of range for this clock
+	uint32_t errorPpm;
+} BrrCase;
+
+static const BrrCase brrTable[] = {
+	{  8000000,   9600,   833,    400 },
+	{  8000000, 115200,    69,   6441 },
+	{  8000000, 230400,    35,   7936 },
+	{  8000000, 460800,    17,  21241 },
+	{  8000000, 921600,     0,      0 },	// PCLK / rate is below the minimum divider of 16
+	{ 36000000,   9600,  3750,      0 },
+	{ 36000000, 115200,   313,   1597 },
+	{ 36000000, 230400,   156,   1602 },
+	{ 36000000, 460800,    78,   1602 },
+	{ 36000000, 921600,    39,   1602 },
+	{ 72000000,   1200, 60000,      0 },
+	{ 72000000,   1000,     0,      0 },	// above the largest divider
+	{ 72000000,   9600,  7500,      0 },
+	{ 72000000, 115200,   625,      0 },
+	{ 72000000, 230400,   313,   1597 },
+	{ 72000000, 460800,   156,   1602 },
+	{ 72000000, 921600,    78,   1602 },
+};
+
+static void checkTable(void)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(brrTable) / sizeof(brrTable[0]); i++) {
+		const BrrCase *c = &brrTable[i];
+		uint32_t errorPpm = 0xFFFFFFFF;
+		uint16_t brr = MCAL_USART_Calculate_BRR(c->pclk, c->baudRate, &errorPpm);
+
+		CHECK_EQ(brr, c->brr);
+		if (c->brr != 0) {
+			CHECK_EQ(errorPpm, c->errorPpm);
+		}
+	}
+
+	// Rates MCAL_USART_Set_Baud_Rate accepts at 8 MHz
+	CHECK(brrTable[1].errorPpm <= USART_BAUD_MAX_ERROR_PPM);
+	CHECK(brrTable[2].errorPpm <= USART_BAUD_MAX_ERROR_PPM);
+	CHECK(brrTable[3].errorPpm > USART_BAUD_MAX_ERROR_PPM);
+
+	CHECK_EQ(MCAL_USART_Calculate_BRR(72000000, 0, NULL), 0);
+	CHECK_EQ(MCAL_USART_Calculate_BRR(72000000, 115200, NULL), 625);
+}
+
+// Distance of the rate of a divider from the wanted one, scaled by both dividers so it stays an integer
+static uint64_t rateDistance(uint32_t pclk, uint32_t baudRate, uint32_t brr, uint32_t other)
+{
+	uint64_t actual = (uint64_t)pclk * other;
+	uint64_t wanted = (uint64_t)baudRate * brr * other;
+
+	return (actual > wanted) ? actual - wanted : wanted - actual;
+}
+
+static void checkNearest(void)
+{
+	static const uint32_t clocks[] = { 8000000, 36000000, 72000000 };
+	size_t i;
+	uint32_t baudRate;
+
+	for (i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++) {
+		uint32_t pclk = clocks[i];
+
+		for (baudRate = 1100; baudRate <= 1000000; baudRate += 37) {
+			uint32_t errorPpm;
+			uint16_t brr = MCAL_USART_Calculate_BRR(pclk, baudRate, &errorPpm);
+			uint32_t exact = pclk / baudRate;
+
+			if ((exact < 15) || (exact > 0xFFFF)) {
+				CHECK_EQ(brr, 0);
+				continue;
+			}
+			if (brr == 0) {
+				// Only a divider rounded past either end of the range
+				CHECK((exact == 15) || (exact == 0xFFFF));
+				continue;
+			}
+
+			// Neither neighbour gets closer to the wanted rate
+			CHECK(rateDistance(pclk, baudRate, brr, brr - 1) <= rateDistance(pclk, baudRate, brr - 1, brr));
+			CHECK(rateDistance(pclk, baudRate, brr, brr + 1) <= rateDistance(pclk, baudRate, brr + 1, brr));
+			CHECK((brr == exact) || (brr == exact + 1));
+
+			// The error is that of the chosen divider
+			CHECK_EQ(errorPpm, (uint32_t)(rateDistance(pclk, baudRate, brr, 1) * 1000000 / ((uint64_t)brr * baudRate)));
+		}
+	}
+}
+
+int main(void)
+{
+	checkTable();
+	checkNearest();
+	return testReport("test_usart_brr");
+}
@@ -0,0 +1,207 @@
+/*
+ * test_usart_rx.c
+ *
+ * Circular DMA reception of the USART driver: USART_RX_DMA_Report splits a
+ * run that wraps past the end of the buffer into two contiguous frames, and
+ * the idle line service reports what the DMA wrote so far, and the bytes
+ * written are counted whether they were reported or not.
+ */
+
+#include "usart_host.h"
+#include "test.h"
+
+#define BUFFER_SIZE 64
+#define MAX_FRAMES 4
+
+typedef struct
+{
+	uint16_t offset;
+	uint16_t length;
+	uint32_t received;		// RX->Received seen by the callback
+} Frame;
+
+static Frame frames[MAX_FRAMES];
+static int frameCount;
+static USART_RX_DMA_t *currentRx;
+
+static void onFrame(uint16_t offset, uint16_t length)
+{
+	if (frameCount < MAX_FRAMES) {
+		frames[frameCount].offset = offset;
+		frames[frameCount].length = length;
+		frames[frameCount].received = currentRx->Received;
+	}
+	frameCount++;
+}
+
+static void resetRx(USART_RX_DMA_t *rx, uint16_t last)
+{
+	memset(rx, 0, sizeof(*rx));
+	rx->Size = BUFFER_SIZE;
+	rx->Last = last;
+	rx->RX_Frame_FN = onFrame;
+	currentRx = rx;
+	frameCount = 0;
+}
+
+static void checkContiguous(void)
+{
+	USART_RX_DMA_t rx;
+
+	resetRx(&rx, 0);
+	USART_RX_DMA_Report(&rx, 10);
+	CHECK_EQ(frameCount, 1);
+	CHECK_EQ(frames[0].offset, 0);
+	CHECK_EQ(frames[0].length, 10);
+	CHECK_EQ(rx.Last, 10);
+	CHECK_EQ(rx.Received, 10);
+
+	// Counted before the callback, which may release the bytes right away
+	CHECK_EQ(frames[0].received, 10);
+
+	frameCount = 0;
+	USART_RX_DMA_Report(&rx, 30);
+	CHECK_EQ(frameCount, 1);
+	CHECK_EQ(frames[0].offset, 10);
+	CHECK_EQ(frames[0].length, 20);
+	CHECK_EQ(rx.Received, 30);
+}
+
+static void checkWrap(void)
+{
+	USART_RX_DMA_t rx;
+	uint16_t last, position;
+
+	// Every start and end of a wrapping run: the tail of the buffer, then its head
+	for (last = 1; last < BUFFER_SIZE; last++) {
+		for (position = 1; position < last; position++) {
+			resetRx(&rx, last);
+			USART_RX_DMA_Report(&rx, position);
+			CHECK_EQ(frameCount, 2);
+			CHECK_EQ(frames[0].offset, last);
+			CHECK_EQ(frames[0].length, BUFFER_SIZE - last);
+			CHECK_EQ(frames[0].received, BUFFER_SIZE - last);
+			CHECK_EQ(frames[1].offset, 0);
+			CHECK_EQ(frames[1].length, position);
+			CHECK_EQ(frames[1].received, BUFFER_SIZE - last + position);
+			CHECK_EQ(rx.Last, position);
+		}
+	}
+
+	// Ending exactly at the end of the buffer is one frame, no empty one at offset 0
+	resetRx(&rx, 60);
+	USART_RX_DMA_Report(&rx, 0);
+	CHECK_EQ(frameCount, 1);
+	CHECK_EQ(frames[0].offset, 60);
+	CHECK_EQ(frames[0].length, 4);
+	CHECK_EQ(rx.Last, 0);
+
+	// The DMA counter reads 0 for an instant before it reloads: the position is the end of the buffer
+	resetRx(&rx, 60);
+	USART_RX_DMA_Report(&rx, BUFFER_SIZE);
+	CHECK_EQ(frameCount, 1);
+	CHECK_EQ(frames[0].length, 4);
+	CHECK_EQ(rx.Last, 0);
+}
+
+static void checkNothingNew(void)
+{
+	USART_RX_DMA_t rx;
+
+	resetRx(&rx, 20);
+	USART_RX_DMA_Report(&rx, 20);
+	CHECK_EQ(frameCount, 0);
+	CHECK_EQ(rx.Received, 0);
+
+	// Without a callback the bytes are skipped, not counted
+	resetRx(&rx, 20);
+	rx.RX_Frame_FN = NULL;
+	USART_RX_DMA_Report(&rx, 40);
+	CHECK_EQ(frameCount, 0);
+	CHECK_EQ(rx.Last, 40);
+	CHECK_EQ(rx.Received, 0);
+}
+
+static void checkIdleService(void)
+{
+	USART_REGISTERS_t registers;
+	USART_Handle_t handle;
+
+	memset(&registers, 0, sizeof(registers));
+	memset(&handle, 0, sizeof(handle));
+	handle.Instance = &registers;
+	handle.RX_DMA_Channel = DMA_USART1_RX_Channel;
+	resetRx(&handle.RX_DMA, 50);
+
+	// IDLE without IDLEIE is left to the DMA callbacks
+	registers.USART_SR = (1 << 4);
+	hostDmaCounter = BUFFER_SIZE - 8;
+	USART_RX_Idle_Service(&handle);
+	CHECK_EQ(frameCount, 0);
+
+	// The line went idle after a run that wrapped
+	registers.USART_CR1 = (1 << 4);
+	USART_RX_Idle_Service(&handle);
+	CHECK_EQ(frameCount, 2);
+	CHECK_EQ(frames[0].offset, 50);
+	CHECK_EQ(frames[0].length, 14);
+	CHECK_EQ(frames[1].offset, 0);
+	CHECK_EQ(frames[1].length, 8);
+
+	// A byte still waiting for the DMA (RXNE) is reported once the DMA took it
+	frameCount = 0;
+	registers.USART_SR = (1 << 4) | (1 << 5);
+	USART_RX_Idle_Service(&handle);
+	CHECK_EQ(frameCount, 0);
+	hostDmaCounter--;
+	USART_RX_Idle_Service(&handle);
+	CHECK_EQ(frameCount, 1);
+	CHECK_EQ(frames[0].offset, 8);
+	CHECK_EQ(frames[0].length, 1);
+	CHECK_EQ(handle.RX_DMA.Received, 23);
+}
+
+static void checkWritten(void)
+{
+	USART_Handle_t handle;
+	uint16_t last, position;
+
+	memset(&handle, 0, sizeof(handle));
+	handle.RX_DMA_Channel = DMA_USART1_RX_Channel;
+
+	// Every report position and DMA position: the reported bytes plus the ones written after them
+	for (last = 0; last < BUFFER_SIZE; last++) {
+		for (position = 0; position < BUFFER_SIZE; position++) {
+			resetRx(&handle.RX_DMA, last);
+			handle.RX_DMA.Received = 1000;
+			hostDmaCounter = BUFFER_SIZE - position;
+			CHECK_EQ(USART_RX_DMA_Written(&handle), 1000 + (position + BUFFER_SIZE - last) % BUFFER_SIZE);
+
+			// Once reported, the same bytes are counted the same
+			USART_RX_DMA_Report(&handle.RX_DMA, position);
+			CHECK_EQ(handle.RX_DMA.Received, 1000 + (position + BUFFER_SIZE - last) % BUFFER_SIZE);
+			CHECK_EQ(USART_RX_DMA_Written(&handle), handle.RX_DMA.Received);
+		}
+	}
+
+	// The counter reads 0 for an instant before it reloads
+	resetRx(&handle.RX_DMA, 60);
+	hostDmaCounter = 0;
+	CHECK_EQ(USART_RX_DMA_Written(&handle), 4);
+
+	// The stream count wraps with the 32 bit counter
+	resetRx(&handle.RX_DMA, 10);
+	handle.RX_DMA.Received = 0xFFFFFFFEu;
+	hostDmaCounter = BUFFER_SIZE - 15;
+	CHECK_EQ(USART_RX_DMA_Written(&handle), 3);
+}
+
+int main(void)
+{
+	checkContiguous();
+	checkWrap();
+	checkNothingNew();
+	checkIdleService();
+	checkWritten();
+	return testReport("test_usart_rx");
+}